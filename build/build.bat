@@ -10,6 +10,9 @@ set CompileTests=1
 set DebugBuild=1
 set CopyToOutputDir=1
 set ConvertToWat=1
+set EnableSimd=1
+rem The shadow stack size in bytes (must be a multiple of 16). Call StdStackGetHighWaterMark() after exercising the app to see how much is actually used
+set StackSize=65536
 
 set LibDirectory=..\lib
 set SourceDirectory=..\source
@@ -23,6 +26,7 @@ if "%DebugBuild%"=="1" (
 	set LibOutputDirectory=%LibDirectory%\release
 )
 set StdMainCodePath=%SourceDirectory%\std_main.c
+set StdNewCodePath=%SourceDirectory%\std_new.cpp
 set TestCodePath=%TestDirectory%\main.cpp
 set TestFileName=%StdLibNameSafe%_Test
 set CombineFilesScript=%WebDirectory%\CombineFiles.py
@@ -44,16 +48,24 @@ rem --target=wasm32 = ?
 rem -mbulk-memory = Prevent conversion of simple loops into memset or memcpy?
 rem -fno-builtin = (Optional) makes some calls like sqrtf actually go to our own sqrtf function rather than linking to the builtin clang implementation
 set CompilerFlags=%CompilerFlags% --no-standard-libraries --no-standard-includes --target=wasm32 -mbulk-memory
+rem -fsized-deallocation = Lets delete pass the size of the allocation to operator delete (see std_new.cpp)
+rem -faligned-allocation = Makes new use the std::align_val_t overloads for over-aligned types (on by default in C++17)
+set CppCompilerFlags=-fsized-deallocation -faligned-allocation
 set IncludeDirectories=-I"%IncludeDirectory%" -I"%SourceDirectory%" -I"%LibDirectory%\include"
 rem --no-entry        = ?
 rem --allow-undefined = ?
 rem --import-memory   = ?
 rem --lto-O2          = ?
-set LinkerFlags=--no-entry --allow-undefined --import-memory --lto-O2
+rem -z stack-size     = Size of the stack that sits between the data section and __heap_base, anything we don't reserve here is given to the heap
+set LinkerFlags=--no-entry --allow-undefined --import-memory --lto-O2 -z stack-size=%StackSize%
 
 if "%DebugBuild%"=="1" (
 	set CompilerFlags=%CompilerFlags% -g
 )
+rem -msimd128 = Enables the SIMD128 paths in string.c (and anything else that checks STD_SIMD_ENABLED)
+if "%EnableSimd%"=="1" (
+	set CompilerFlags=%CompilerFlags% -msimd128
+)
 
 rem +--------------------------------------------------------------+
 rem |                       Test Compilation                       |
@@ -65,7 +77,7 @@ rem clang "%TestCodePath%" -c %CompilerFlags% %IncludeDirectories% -o "%TestFile
 
 if "%CompileLibrary%"=="1" (
 	echo [Compiling PigWasmStdLib...]
-	clang "%StdMainCodePath%" %CompilerFlags% %IncludeDirectories% -Wl,--relocatable -o "%StdLibNameSafe%.wasm"
+	clang "%StdMainCodePath%" "%StdNewCodePath%" %CompilerFlags% %IncludeDirectories% -Wl,--relocatable -o "%StdLibNameSafe%.wasm"
 	
 	if "%CopyToOutputDir%"=="1" (
 		echo [Copying %StdLibNameSafe%.wasm to %LibOutputDirectory%...]
@@ -75,7 +87,7 @@ if "%CompileLibrary%"=="1" (
 
 if "%CompileTests%"=="1" (
 	echo [Compiling Tests...]
-	clang "%TestCodePath%" -c %CompilerFlags% %IncludeDirectories% -o "%TestFileName%.o"
+	clang "%TestCodePath%" -c %CompilerFlags% %CppCompilerFlags% %IncludeDirectories% -o "%TestFileName%.o"
 	echo [Linking...]
 	wasm-ld "%StdLibNameSafe%.wasm" "%TestFileName%.o" %LinkerFlags% -o %TestFileName%.wasm
 	
@@ -0,0 +1,55 @@
+/*
+File:   ctype.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Character classification and case conversion. We only support the "C" locale so everything
+	** here only looks at ASCII, bytes 0x80 and above are never letters, digits, spaces, etc.
+*/
+
+#ifndef _CTYPE_H
+#define _CTYPE_H
+
+#include <internal/std_common.h>
+
+CONDITIONAL_EXTERN_C_START
+
+int isalnum(int c);
+int isalpha(int c);
+int isblank(int c);
+int iscntrl(int c);
+int isdigit(int c);
+int isgraph(int c);
+int islower(int c);
+int isprint(int c);
+int ispunct(int c);
+int isspace(int c);
+int isupper(int c);
+int isxdigit(int c);
+int tolower(int c);
+int toupper(int c);
+
+CONDITIONAL_EXTERN_C_END
+
+#endif //  _CTYPE_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Functions
+int isalnum(int c)
+int isalpha(int c)
+int isblank(int c)
+int iscntrl(int c)
+int isdigit(int c)
+int isgraph(int c)
+int islower(int c)
+int isprint(int c)
+int ispunct(int c)
+int isspace(int c)
+int isupper(int c)
+int isxdigit(int c)
+int tolower(int c)
+int toupper(int c)
+*/
@@ -12,7 +12,7 @@ Description:
 WASM_IMPORTED_FUNC _Noreturn void jsStdAbort(const char* messageStrPntr, int exitCode);
 WASM_IMPORTED_FUNC _Noreturn void jsStdAssertFailure(const char* filePathPntr, int fileLineNum, const char* funcNamePntr, const char* conditionStrPntr, const char* messageStrPntr);
 WASM_IMPORTED_FUNC void jsStdDebugBreak();
-WASM_IMPORTED_FUNC void jsStdGrowMemory(unsigned int numPages);
+WASM_IMPORTED_FUNC void jsStdMemoryGrown(unsigned int prevNumPages, unsigned int newNumPages);
 WASM_IMPORTED_FUNC unsigned int jsStdGetHeapSize();
 
 #endif //  _STD_JS_API_H
@@ -25,6 +25,6 @@ WASM_IMPORTED_FUNC unsigned int jsStdGetHeapSize();
 void jsStdAbort(const char* messageStrPntr, int exitCode)
 void jsStdAssertFailure(const char* filePathPntr, int fileLineNum, const char* funcNamePntr, const char* conditionStrPntr, const char* messageStrPntr)
 void jsStdDebugBreak()
-void jsStdGrowMemory(unsigned int numPages)
+void jsStdMemoryGrown(unsigned int prevNumPages, unsigned int newNumPages)
 unsigned int jsStdGetHeapSize()
 */
@@ -0,0 +1,68 @@
+/*
+File:   std_simd.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Vector types and small helpers for the parts of the library that have a SIMD128 path (compiled with -msimd128).
+	** We can't include clang's wasm_simd128.h (we compile with --no-standard-includes) so this uses clang's
+	** vector extensions directly, comparisons between two vectors produce a lane mask of all 1s or all 0s.
+	** Only used internally by the .c files, std_main.c includes this after all the public headers
+*/
+
+#ifndef _STD_SIMD_H
+#define _STD_SIMD_H
+
+#ifdef __wasm_simd128__
+#define STD_SIMD_ENABLED 1
+#else
+#define STD_SIMD_ENABLED 0
+#endif
+
+#if STD_SIMD_ENABLED
+
+// may_alias lets us read any buffer through these types, the aligned versions should be used whenever we
+// can round a pointer down to a 16-byte boundary since an aligned load can never run off the end of memory
+typedef uint8_t  StdU8x16_t   __attribute__((__vector_size__(16), __aligned__(16), __may_alias__));
+typedef int8_t   StdI8x16_t   __attribute__((__vector_size__(16), __aligned__(16), __may_alias__));
+typedef uint32_t StdU32x4_t   __attribute__((__vector_size__(16), __aligned__(16), __may_alias__));
+typedef int32_t  StdI32x4_t   __attribute__((__vector_size__(16), __aligned__(16), __may_alias__));
+typedef uint8_t  StdU8x16U_t  __attribute__((__vector_size__(16), __aligned__(1),  __may_alias__)); //unaligned
+typedef uint16_t StdU16x8U_t  __attribute__((__vector_size__(16), __aligned__(1),  __may_alias__)); //unaligned
+typedef uint32_t StdU32x4U_t  __attribute__((__vector_size__(16), __aligned__(1),  __may_alias__)); //unaligned
+typedef int32_t  StdI32x4U_t  __attribute__((__vector_size__(16), __aligned__(1),  __may_alias__)); //unaligned
+
+#define STD_SIMD_SIZE 16
+#define StdSimdAlignDown(pntr) ((const StdU8x16_t*)((uintptr_t)(pntr) & ~(uintptr_t)(STD_SIMD_SIZE-1)))
+
+// An unaligned 16-byte load is safe even if only the first byte belongs to us, as long as it doesn't cross into the next
+// wasm page. Memory always ends on a page boundary so a load that stays in the same page can't run off the end of memory
+static inline bool StdSimdIsLoadPageSafe(const void* pntr)
+{
+	return (((uintptr_t)pntr & (WASM_MEMORY_PAGE_SIZE-1)) <= (WASM_MEMORY_PAGE_SIZE - STD_SIMD_SIZE));
+}
+
+static inline StdU8x16_t StdSimdSplatU8(uint8_t value)
+{
+	return (StdU8x16_t){ value, value, value, value, value, value, value, value, value, value, value, value, value, value, value, value };
+}
+
+static inline StdI32x4_t StdSimdSplatI32(int32_t value)
+{
+	return (StdI32x4_t){ value, value, value, value };
+}
+
+// Packs the top bit of each lane of a comparison result into the low 16 bits (i8x16.bitmask), lane 0 is bit 0
+static inline uint32_t StdSimdMask(StdI8x16_t laneMask)
+{
+	return (uint32_t)__builtin_wasm_bitmask_i8x16(laneMask);
+}
+
+// Uses each lane of indices to pick a lane from table (i8x16.swizzle), indices of 16 or more give 0
+static inline StdU8x16_t StdSimdSwizzle(StdU8x16_t table, StdU8x16_t indices)
+{
+	return (StdU8x16_t)__builtin_wasm_swizzle_i8x16((StdI8x16_t)table, (StdI8x16_t)indices);
+}
+
+#endif //STD_SIMD_ENABLED
+
+#endif //  _STD_SIMD_H
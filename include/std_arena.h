@@ -0,0 +1,69 @@
+/*
+File:   std_arena.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** A simple bump allocator (arena) that lives outside of the malloc/free heap.
+	** Memory is pushed off the front of the arena and is only given back all at once,
+	** either by popping back to a mark that was saved earlier or by resetting the whole arena.
+	** There is also a pair of frame arenas: the host calls StdBeginFrame at the start of each frame and
+	** anything pushed with StdFramePush stays valid until the end of the frame after the one it was pushed in.
+*/
+
+#ifndef _STD_ARENA_H
+#define _STD_ARENA_H
+
+#include <internal/std_common.h>
+#include "stdint.h"
+#include "stdbool.h"
+
+CONDITIONAL_EXTERN_C_START
+
+typedef struct StdArena_t StdArena_t;
+struct StdArena_t
+{
+	uint8_t* basePntr;
+	uint32_t size;
+	uint32_t used;
+	uint32_t highUsedMark; //the most that has ever been used at once, useful for sizing the arena
+};
+
+typedef uint32_t StdArenaMark_t;
+
+void InitStdArena(StdArena_t* arena, void* memoryPntr, uint32_t memorySize);
+void InitStdArenaPages(StdArena_t* arena, uint32_t numPages);
+void* StdArenaPush(StdArena_t* arena, uint32_t numBytes, uint32_t alignment);
+StdArenaMark_t StdArenaPushMark(const StdArena_t* arena);
+void StdArenaPopMark(StdArena_t* arena, StdArenaMark_t mark);
+void StdArenaReset(StdArena_t* arena);
+
+void InitStdFrameArenas(uint32_t numPagesPerFrame);
+void StdBeginFrame();
+void* StdFramePush(uint32_t numBytes, uint32_t alignment);
+StdArena_t* GetStdFrameArena();
+StdArena_t* GetStdPrevFrameArena();
+
+CONDITIONAL_EXTERN_C_END
+
+#endif //  _STD_ARENA_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Types
+StdArena_t
+StdArenaMark_t
+@Functions
+void InitStdArena(StdArena_t* arena, void* memoryPntr, uint32_t memorySize)
+void InitStdArenaPages(StdArena_t* arena, uint32_t numPages)
+void* StdArenaPush(StdArena_t* arena, uint32_t numBytes, uint32_t alignment)
+StdArenaMark_t StdArenaPushMark(const StdArena_t* arena)
+void StdArenaPopMark(StdArena_t* arena, StdArenaMark_t mark)
+void StdArenaReset(StdArena_t* arena)
+void InitStdFrameArenas(uint32_t numPagesPerFrame)
+void StdBeginFrame()
+void* StdFramePush(uint32_t numBytes, uint32_t alignment)
+StdArena_t* GetStdFrameArena()
+StdArena_t* GetStdPrevFrameArena()
+*/
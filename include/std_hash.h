@@ -0,0 +1,125 @@
+/*
+File:   std_hash.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Fast non-cryptographic 64-bit hashing. The output is identical to XXH64 (from xxHash) so hashes can be
+	** computed offline by tools with any xxHash implementation and compared against ones computed at runtime.
+	** StdHash64 hashes a buffer in one go, StdHashStart/Update/Finish does the same thing for data that arrives in pieces
+	** and in C++ StdHash64Constexpr (or StdHashLiteral) can produce the same hash at compile time for things like switch case labels
+*/
+
+#ifndef _STD_HASH_H
+#define _STD_HASH_H
+
+#include <internal/std_common.h>
+#include "stdint.h"
+
+CONDITIONAL_EXTERN_C_START
+
+#define STD_HASH_PRIME1 0x9E3779B185EBCA87ULL
+#define STD_HASH_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define STD_HASH_PRIME3 0x165667B19E3779F9ULL
+#define STD_HASH_PRIME4 0x85EBCA77C2B2AE63ULL
+#define STD_HASH_PRIME5 0x27D4EB2F165667C5ULL
+#define STD_HASH_STRIPE_SIZE 32
+
+typedef struct StdHashState_t StdHashState_t;
+struct StdHashState_t
+{
+	uint64_t totalNumBytes;
+	uint64_t seed;
+	uint64_t accumulators[4];
+	uint8_t buffer[STD_HASH_STRIPE_SIZE]; //holds the start of a stripe that hasn't been completed by an update yet
+	uint32_t bufferSize;
+};
+
+uint64_t StdHash64(const void* dataPntr, size_t numBytes, uint64_t seed);
+uint64_t StdHashStr64(const char* nullTermStr, uint64_t seed);
+
+void StdHashStart(StdHashState_t* state, uint64_t seed);
+void StdHashUpdate(StdHashState_t* state, const void* dataPntr, size_t numBytes);
+uint64_t StdHashFinish(const StdHashState_t* state);
+
+CONDITIONAL_EXTERN_C_END
+
+// +--------------------------------------------------------------+
+// |                      Constexpr Version                       |
+// +--------------------------------------------------------------+
+#if LANGUAGE_CPP
+// Same algorithm as StdHash64 but written so it can be evaluated at compile time (C++14 or newer). Bytes are
+// put together one at a time here so this is much slower than StdHash64 if it ends up being evaluated at runtime
+constexpr uint64_t StdHashConstRotl(uint64_t value, uint32_t amount) { return (value << amount) | (value >> (64 - amount)); }
+constexpr uint64_t StdHashConstRound(uint64_t accumulator, uint64_t input) { return StdHashConstRotl(accumulator + (input * STD_HASH_PRIME2), 31) * STD_HASH_PRIME1; }
+constexpr uint64_t StdHashConstMergeRound(uint64_t hash, uint64_t accumulator) { return ((hash ^ StdHashConstRound(0, accumulator)) * STD_HASH_PRIME1) + STD_HASH_PRIME4; }
+constexpr uint64_t StdHashConstRead(const char* dataPntr, size_t offset, uint32_t numBytes)
+{
+	uint64_t result = 0;
+	for (uint32_t bIndex = 0; bIndex < numBytes; bIndex++) { result |= ((uint64_t)(uint8_t)dataPntr[offset + bIndex] << (bIndex * 8)); }
+	return result;
+}
+
+constexpr uint64_t StdHash64Constexpr(const char* dataPntr, size_t numBytes, uint64_t seed = 0)
+{
+	size_t offset = 0;
+	uint64_t hash = 0;
+	if (numBytes >= STD_HASH_STRIPE_SIZE)
+	{
+		uint64_t acc1 = seed + STD_HASH_PRIME1 + STD_HASH_PRIME2;
+		uint64_t acc2 = seed + STD_HASH_PRIME2;
+		uint64_t acc3 = seed;
+		uint64_t acc4 = seed - STD_HASH_PRIME1;
+		for (; offset + STD_HASH_STRIPE_SIZE <= numBytes; offset += STD_HASH_STRIPE_SIZE)
+		{
+			acc1 = StdHashConstRound(acc1, StdHashConstRead(dataPntr, offset + 0, 8));
+			acc2 = StdHashConstRound(acc2, StdHashConstRead(dataPntr, offset + 8, 8));
+			acc3 = StdHashConstRound(acc3, StdHashConstRead(dataPntr, offset + 16, 8));
+			acc4 = StdHashConstRound(acc4, StdHashConstRead(dataPntr, offset + 24, 8));
+		}
+		hash = StdHashConstRotl(acc1, 1) + StdHashConstRotl(acc2, 7) + StdHashConstRotl(acc3, 12) + StdHashConstRotl(acc4, 18);
+		hash = StdHashConstMergeRound(hash, acc1);
+		hash = StdHashConstMergeRound(hash, acc2);
+		hash = StdHashConstMergeRound(hash, acc3);
+		hash = StdHashConstMergeRound(hash, acc4);
+	}
+	else { hash = seed + STD_HASH_PRIME5; }
+	hash += (uint64_t)numBytes;
+	
+	for (; offset + 8 <= numBytes; offset += 8) { hash = (StdHashConstRotl(hash ^ StdHashConstRound(0, StdHashConstRead(dataPntr, offset, 8)), 27) * STD_HASH_PRIME1) + STD_HASH_PRIME4; }
+	if (offset + 4 <= numBytes) { hash = (StdHashConstRotl(hash ^ (StdHashConstRead(dataPntr, offset, 4) * STD_HASH_PRIME1), 23) * STD_HASH_PRIME2) + STD_HASH_PRIME3; offset += 4; }
+	for (; offset < numBytes; offset++) { hash = StdHashConstRotl(hash ^ ((uint64_t)(uint8_t)dataPntr[offset] * STD_HASH_PRIME5), 11) * STD_HASH_PRIME1; }
+	
+	hash ^= (hash >> 33); hash *= STD_HASH_PRIME2;
+	hash ^= (hash >> 29); hash *= STD_HASH_PRIME3;
+	hash ^= (hash >> 32);
+	return hash;
+}
+
+// Hashes a string literal (without it's null-terminator), the same as StdHashStr64(str, 0)
+template<size_t N> constexpr uint64_t StdHashLiteral(const char (&str)[N]) { return StdHash64Constexpr(&str[0], N-1, 0); }
+#endif //LANGUAGE_CPP
+
+#endif //  _STD_HASH_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+STD_HASH_PRIME1
+STD_HASH_PRIME2
+STD_HASH_PRIME3
+STD_HASH_PRIME4
+STD_HASH_PRIME5
+STD_HASH_STRIPE_SIZE
+@Types
+StdHashState_t
+@Functions
+uint64_t StdHash64(const void* dataPntr, size_t numBytes, uint64_t seed)
+uint64_t StdHashStr64(const char* nullTermStr, uint64_t seed)
+void StdHashStart(StdHashState_t* state, uint64_t seed)
+void StdHashUpdate(StdHashState_t* state, const void* dataPntr, size_t numBytes)
+uint64_t StdHashFinish(const StdHashState_t* state)
+uint64_t StdHash64Constexpr(const char* dataPntr, size_t numBytes, uint64_t seed = 0)
+uint64_t StdHashLiteral(const char (&str)[N])
+*/
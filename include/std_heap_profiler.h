@@ -0,0 +1,33 @@
+/*
+File:   std_heap_profiler.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Controls for the sampling heap profiler in std_wasm_memory.c. The profiler only records anything
+	** if the library was compiled with WASM_HEAP_PROFILER_ENABLED=1, otherwise these functions do nothing.
+	** Samples are read and grouped by tag on the javascript side with PigWasm_GetHeapProfile()
+*/
+
+#ifndef _STD_HEAP_PROFILER_H
+#define _STD_HEAP_PROFILER_H
+
+#include <internal/std_common.h>
+#include "stdint.h"
+
+CONDITIONAL_EXTERN_C_START
+
+const char* StdHeapProfilerSetTag(const char* tagName); //returns the previous tag so it can be restored
+void StdHeapProfilerSetInterval(uint32_t numBytes);
+
+CONDITIONAL_EXTERN_C_END
+
+#endif //  _STD_HEAP_PROFILER_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Functions
+const char* StdHeapProfilerSetTag(const char* tagName)
+void StdHeapProfilerSetInterval(uint32_t numBytes)
+*/
@@ -0,0 +1,40 @@
+/*
+File:   std_stack.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Measures how much of the shadow stack (the part of linear memory that clang uses for locals
+	** that need an address, big structs and alloca) is actually used. The unused part of the stack is
+	** painted with STD_STACK_PAINT_VALUE by InitStdLib and StdStackGetHighWaterMark scans for the deepest word
+	** that has been overwritten since then. The stack size is set at link time with -z stack-size (see build.bat)
+*/
+
+#ifndef _STD_STACK_H
+#define _STD_STACK_H
+
+#include <internal/std_common.h>
+#include "stdint.h"
+
+CONDITIONAL_EXTERN_C_START
+
+#define STD_STACK_PAINT_VALUE 0xC5C5C5C5
+
+uint32_t StdStackGetSize();
+uint32_t StdStackGetUsed();
+uint32_t StdStackGetHighWaterMark();
+
+CONDITIONAL_EXTERN_C_END
+
+#endif //  _STD_STACK_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+STD_STACK_PAINT_VALUE
+@Functions
+uint32_t StdStackGetSize()
+uint32_t StdStackGetUsed()
+uint32_t StdStackGetHighWaterMark()
+*/
@@ -0,0 +1,57 @@
+/*
+File:   std_utf.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Validation and conversion between UTF-8 (what we store text as) and UTF-16 (what javascript strings use) or
+	** UTF-32 (wchar_t is 32-bit in wasm so a wchar_t string can be passed as a uint32_t pointer). Nothing here needs
+	** the strings to be null-terminated and none of the conversions write a terminator.
+	** The conversion functions return the number of code units written to bufferOut, or STD_UTF_INVALID if the input
+	** isn't valid. bufferOut must be big enough for the worst case (see the comments below) or for the exact length
+	** returned by the matching Length function. The Length functions assume the input is valid
+*/
+
+#ifndef _STD_UTF_H
+#define _STD_UTF_H
+
+#include <internal/std_common.h>
+#include "stdint.h"
+#include "stdbool.h"
+
+CONDITIONAL_EXTERN_C_START
+
+#define STD_UTF_INVALID ((size_t)-1)
+
+bool StdUtf8Validate(const char* str, size_t numBytes);
+
+size_t StdUtf16LengthFromUtf8(const char* str, size_t numBytes);
+size_t StdUtf32LengthFromUtf8(const char* str, size_t numBytes);
+size_t StdUtf8LengthFromUtf16(const uint16_t* str, size_t numUnits);
+size_t StdUtf8LengthFromUtf32(const uint32_t* str, size_t numUnits);
+
+size_t StdUtf8ToUtf16(const char* str, size_t numBytes, uint16_t* bufferOut); //bufferOut needs room for numBytes units
+size_t StdUtf8ToUtf32(const char* str, size_t numBytes, uint32_t* bufferOut); //bufferOut needs room for numBytes units
+size_t StdUtf16ToUtf8(const uint16_t* str, size_t numUnits, char* bufferOut); //bufferOut needs room for numUnits*3 bytes
+size_t StdUtf32ToUtf8(const uint32_t* str, size_t numUnits, char* bufferOut); //bufferOut needs room for numUnits*4 bytes
+
+CONDITIONAL_EXTERN_C_END
+
+#endif //  _STD_UTF_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+STD_UTF_INVALID
+@Functions
+bool StdUtf8Validate(const char* str, size_t numBytes)
+size_t StdUtf16LengthFromUtf8(const char* str, size_t numBytes)
+size_t StdUtf32LengthFromUtf8(const char* str, size_t numBytes)
+size_t StdUtf8LengthFromUtf16(const uint16_t* str, size_t numUnits)
+size_t StdUtf8LengthFromUtf32(const uint32_t* str, size_t numUnits)
+size_t StdUtf8ToUtf16(const char* str, size_t numBytes, uint16_t* bufferOut)
+size_t StdUtf8ToUtf32(const char* str, size_t numBytes, uint32_t* bufferOut)
+size_t StdUtf16ToUtf8(const uint16_t* str, size_t numUnits, char* bufferOut)
+size_t StdUtf32ToUtf8(const uint32_t* str, size_t numUnits, char* bufferOut)
+*/
@@ -21,14 +21,26 @@ void* malloc(size_t numBytes);
 void* calloc(size_t numElements, size_t elemSize);
 void* realloc(void* prevAllocPntr, size_t newSize);
 void free(void* allocPntr);
-void* aligned_alloc(size_t numBytes, size_t alignmentSize);
+void* aligned_alloc(size_t alignmentSize, size_t numBytes);
 
 #define RAND_MAX (0x7FFFFFFF)
 void srand(unsigned int seed);
 int rand();
 
 double atof(const char* str);
-void* alloca(size_t numBytes);
+
+// alloca has to be a macro, memory from __builtin_alloca is released when the function that called it returns.
+// When STD_ALLOCA_CHECK_ENABLED the request is checked against the space left on the stack before the stack pointer moves
+#ifndef STD_ALLOCA_CHECK_ENABLED
+#define STD_ALLOCA_CHECK_ENABLED STD_ASSERTIONS_ENABLED
+#endif
+void* (alloca)(size_t numBytes);
+#if STD_ALLOCA_CHECK_ENABLED
+size_t StdStackCheckAlloca(size_t numBytes);
+#define alloca(numBytes) __builtin_alloca(StdStackCheckAlloca(numBytes))
+#else
+#define alloca(numBytes) __builtin_alloca(numBytes)
+#endif
 
 void qsort(void* basePntr, size_t numItems, size_t itemSize, StdCompareFunc_f* compareFunc);
 
@@ -44,6 +56,7 @@ CONDITIONAL_EXTERN_C_END
 /*
 @Defines
 RAND_MAX
+STD_ALLOCA_CHECK_ENABLED
 @Types
 StdCompareFunc_f
 @Functions
@@ -52,7 +65,7 @@ void* malloc(size_t numBytes)
 void* calloc(size_t numElements, size_t elemSize)
 void* realloc(void* prevAllocPntr, size_t newSize)
 void free(void* allocPntr)
-void* aligned_alloc(size_t numBytes, size_t alignmentSize)
+void* aligned_alloc(size_t alignmentSize, size_t numBytes)
 void srand(unsigned int seed)
 int rand()
 double atof(const char* str)
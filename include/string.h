@@ -20,12 +20,26 @@ void* _memmove(void* dest, const void* source, size_t numBytes);
 #define memmove(dest, source, numBytes) _memmove((dest), (source), (numBytes))
 char* strcpy(char* dest, const char* source);
 char* strstr(const char* haystack, const char* needle);
-
-
+void* memmem(const void* haystack, size_t haystackLen, const void* needle, size_t needleLen);
+void* memchr(const void* pntr, int targetChar, size_t numBytes);
+char* strchr(const char* str, int targetChar);
+char* strrchr(const char* str, int targetChar);
+size_t strspn(const char* str, const char* charSet);
+size_t strcspn(const char* str, const char* charSet);
+char* strpbrk(const char* str, const char* charSet);
+char* strtok(char* str, const char* separators);
+char* strtok_r(char* str, const char* separators, char** savePntr);
+char* strcasestr(const char* haystack, const char* needle);
+void StdStrToLowerInPlace(char* str, size_t numBytes);
+void StdStrToUpperInPlace(char* str, size_t numBytes);
 int strcmp(const char* left, const char* right);
 int strncmp(const char* left, const char* right, size_t numBytes);
 size_t strlen(const char* str);
 size_t wcslen(const wchar_t* str);
+wchar_t* wcschr(const wchar_t* str, wchar_t targetChar);
+int wcscmp(const wchar_t* left, const wchar_t* right);
+wchar_t* wmemcpy(wchar_t* dest, const wchar_t* source, size_t numChars);
+wchar_t* wmemset(wchar_t* dest, wchar_t value, size_t numChars);
 
 CONDITIONAL_EXTERN_C_END
 
@@ -42,8 +56,24 @@ void* memcpy(void* dest, const void* source, size_t numBytes)
 void* memmove(void* dest, const void* source, size_t numBytes)
 void* strcpy(void* dest, const void* source)
 char* strstr(const char* haystack, const char* needle)
+void* memmem(const void* haystack, size_t haystackLen, const void* needle, size_t needleLen)
+void* memchr(const void* pntr, int targetChar, size_t numBytes)
+char* strchr(const char* str, int targetChar)
+char* strrchr(const char* str, int targetChar)
+size_t strspn(const char* str, const char* charSet)
+size_t strcspn(const char* str, const char* charSet)
+char* strpbrk(const char* str, const char* charSet)
+char* strtok(char* str, const char* separators)
+char* strtok_r(char* str, const char* separators, char** savePntr)
+char* strcasestr(const char* haystack, const char* needle)
+void StdStrToLowerInPlace(char* str, size_t numBytes)
+void StdStrToUpperInPlace(char* str, size_t numBytes)
 int strcmp(const char* left, const char* right)
 int strncmp(const char* left, const char* right, size_t numBytes)
 size_t strlen(const char* str)
 size_t wcslen(const wchar_t* str)
+wchar_t* wcschr(const wchar_t* str, wchar_t targetChar)
+int wcscmp(const wchar_t* left, const wchar_t* right)
+wchar_t* wmemcpy(wchar_t* dest, const wchar_t* source, size_t numChars)
+wchar_t* wmemset(wchar_t* dest, wchar_t value, size_t numChars)
 */
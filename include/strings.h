@@ -0,0 +1,31 @@
+/*
+File:   strings.h
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** The POSIX header for case-insensitive string comparison. Only ASCII letters are folded (the "C" locale).
+	** These are implemented in string.c alongside the case sensitive versions
+*/
+
+#ifndef _STRINGS_H
+#define _STRINGS_H
+
+#include <internal/std_common.h>
+
+CONDITIONAL_EXTERN_C_START
+
+int strcasecmp(const char* left, const char* right);
+int strncasecmp(const char* left, const char* right, size_t numBytes);
+
+CONDITIONAL_EXTERN_C_END
+
+#endif //  _STRINGS_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Functions
+int strcasecmp(const char* left, const char* right)
+int strncasecmp(const char* left, const char* right, size_t numBytes)
+*/
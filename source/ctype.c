@@ -0,0 +1,25 @@
+/*
+File:   ctype.c
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Holds all the implementations for functions declared in ctype.h
+	** NOTE: Most of these use a single unsigned compare for a range check, (c - 'a') < 26 is false
+	**       for anything below 'a' since it wraps around to a large number
+*/
+
+int isalnum(int c) { return (isalpha(c) || isdigit(c)); }
+int isalpha(int c) { return (((unsigned)c | 0x20) - 'a' < 26); }
+int isblank(int c) { return (c == ' ' || c == '\t'); }
+int iscntrl(int c) { return ((unsigned)c < 0x20 || c == 0x7F); }
+int isdigit(int c) { return ((unsigned)c - '0' < 10); }
+int isgraph(int c) { return ((unsigned)c - 0x21 < 0x5E); }
+int islower(int c) { return ((unsigned)c - 'a' < 26); }
+int isprint(int c) { return ((unsigned)c - 0x20 < 0x5F); }
+int ispunct(int c) { return (isgraph(c) && !isalnum(c)); }
+int isspace(int c) { return (c == ' ' || (unsigned)c - '\t' < 5); }
+int isupper(int c) { return ((unsigned)c - 'A' < 26); }
+int isxdigit(int c) { return (isdigit(c) || ((unsigned)c | 0x20) - 'a' < 6); }
+
+int tolower(int c) { return (isupper(c) ? (c | 0x20) : c); }
+int toupper(int c) { return (islower(c) ? (c & 0x5F) : c); }
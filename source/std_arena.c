@@ -0,0 +1,106 @@
+/*
+File:   std_arena.c
+Author: Taylor Robbins
+Date:   10\17\2026
+Description: 
+	** Holds all the implementations for functions declared in std_arena.h
+*/
+
+// When enabled the frame arena that StdBeginFrame resets is filled with STD_FRAME_ARENA_POISON_VALUE first
+// so anything still pointing into it from two frames ago reads obvious garbage instead of stale (but plausible) data
+#ifndef STD_FRAME_ARENA_POISON_ENABLED
+#define STD_FRAME_ARENA_POISON_ENABLED STD_ASSERTIONS_ENABLED
+#endif
+#define STD_FRAME_ARENA_POISON_VALUE 0xDD
+
+StdArena_t StdFrameArenas[2];
+uint32_t StdFrameArenaIndex = 0;
+
+void InitStdArena(StdArena_t* arena, void* memoryPntr, uint32_t memorySize)
+{
+	assert(arena != nullptr);
+	assert(memoryPntr != nullptr || memorySize == 0);
+	arena->basePntr = (uint8_t*)memoryPntr;
+	arena->size = memorySize;
+	arena->used = 0;
+	arena->highUsedMark = 0;
+}
+
+// Takes whole pages from the wasm memory directly, these pages will never be available to malloc
+void InitStdArenaPages(StdArena_t* arena, uint32_t numPages)
+{
+	assert(numPages > 0);
+	InitStdArena(arena, WasmMemoryAllocatePages(numPages), numPages * WASM_MEMORY_PAGE_SIZE);
+}
+
+// alignment must be a power of 2 (or 0 for no alignment), returns nullptr if the arena doesn't have enough space left
+void* StdArenaPush(StdArena_t* arena, uint32_t numBytes, uint32_t alignment)
+{
+	assert((alignment & (alignment-1)) == 0);
+	uint32_t address = (uint32_t)arena->basePntr + arena->used;
+	uint32_t alignPadding = ((alignment > 1) ? ((alignment - (address & (alignment-1))) & (alignment-1)) : 0);
+	// Compared against the space left rather than adding numBytes + alignPadding, which could wrap around for huge numBytes
+	if (alignPadding > arena->size - arena->used || numBytes > arena->size - arena->used - alignPadding) { return nullptr; }
+	
+	void* result = arena->basePntr + arena->used + alignPadding;
+	arena->used += alignPadding + numBytes;
+	if (arena->used > arena->highUsedMark) { arena->highUsedMark = arena->used; }
+	return result;
+}
+
+StdArenaMark_t StdArenaPushMark(const StdArena_t* arena)
+{
+	return arena->used;
+}
+
+// Everything pushed after the mark was taken is released. Marks must be popped in the reverse order they were pushed
+void StdArenaPopMark(StdArena_t* arena, StdArenaMark_t mark)
+{
+	assert(mark <= arena->used);
+	arena->used = mark;
+}
+
+void StdArenaReset(StdArena_t* arena)
+{
+	arena->used = 0;
+}
+
+// +--------------------------------------------------------------+
+// |                        Frame Arenas                          |
+// +--------------------------------------------------------------+
+void InitStdFrameArenas(uint32_t numPagesPerFrame)
+{
+	InitStdArenaPages(&StdFrameArenas[0], numPagesPerFrame);
+	InitStdArenaPages(&StdFrameArenas[1], numPagesPerFrame);
+	StdFrameArenaIndex = 0;
+}
+
+// Swaps which frame arena is current and resets it. The arena that was current up until now becomes the previous
+// frame's arena and stays valid for one more frame, so data can be handed from one frame to the next without copying
+// void StdBeginFrame()
+WASM_EXPORTED_FUNC(void, StdBeginFrame)
+{
+	StdFrameArenaIndex = (StdFrameArenaIndex + 1) % 2;
+	StdArena_t* frameArena = &StdFrameArenas[StdFrameArenaIndex];
+	#if STD_FRAME_ARENA_POISON_ENABLED
+	if (frameArena->used > 0) { memset(frameArena->basePntr, STD_FRAME_ARENA_POISON_VALUE, frameArena->used); }
+	#endif
+	StdArenaReset(frameArena);
+}
+
+// Returns nullptr if the current frame arena is full (check GetStdFrameArena()->highUsedMark to size the arenas)
+void* StdFramePush(uint32_t numBytes, uint32_t alignment)
+{
+	assert(StdFrameArenas[StdFrameArenaIndex].basePntr != nullptr && "InitStdFrameArenas must be called before StdFramePush!");
+	return StdArenaPush(&StdFrameArenas[StdFrameArenaIndex], numBytes, alignment);
+}
+
+StdArena_t* GetStdFrameArena()
+{
+	return &StdFrameArenas[StdFrameArenaIndex];
+}
+
+StdArena_t* GetStdPrevFrameArena()
+{
+	return &StdFrameArenas[(StdFrameArenaIndex + 1) % 2];
+}
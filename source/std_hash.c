@@ -0,0 +1,164 @@
+/*
+File:   std_hash.c
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Holds all the implementations for functions declared in std_hash.h
+	** NOTE: Everything here is built on 64-bit multiplies and rotates, which map directly to i64.mul and i64.rotl.
+	**       There's no SIMD path since wasm has no fast 64x64 lane multiply (i64x2.mul gets emulated on most x64 machines)
+*/
+
+typedef uint32_t __attribute__((__may_alias__, __aligned__(1))) a_hash_u32;
+typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) a_hash_u64;
+
+static inline uint64_t StdHashRotl(uint64_t value, uint32_t amount)
+{
+	return __builtin_rotateleft64(value, amount);
+}
+
+static inline uint64_t StdHashRound(uint64_t accumulator, uint64_t input)
+{
+	accumulator += input * STD_HASH_PRIME2;
+	accumulator = StdHashRotl(accumulator, 31);
+	return accumulator * STD_HASH_PRIME1;
+}
+
+static inline uint64_t StdHashMergeRound(uint64_t hash, uint64_t accumulator)
+{
+	hash ^= StdHashRound(0, accumulator);
+	return (hash * STD_HASH_PRIME1) + STD_HASH_PRIME4;
+}
+
+static inline void StdHashInitAccumulators(uint64_t* accumulators, uint64_t seed)
+{
+	accumulators[0] = seed + STD_HASH_PRIME1 + STD_HASH_PRIME2;
+	accumulators[1] = seed + STD_HASH_PRIME2;
+	accumulators[2] = seed;
+	accumulators[3] = seed - STD_HASH_PRIME1;
+}
+
+// Runs all the full 32 byte stripes in the data through the accumulators and returns a pointer to the first byte that wasn't consumed
+static inline const uint8_t* StdHashStripes(uint64_t* accumulators, const uint8_t* bytePntr, const uint8_t* endPntr)
+{
+	uint64_t acc1 = accumulators[0], acc2 = accumulators[1], acc3 = accumulators[2], acc4 = accumulators[3];
+	for (; (size_t)(endPntr - bytePntr) >= STD_HASH_STRIPE_SIZE; bytePntr += STD_HASH_STRIPE_SIZE)
+	{
+		acc1 = StdHashRound(acc1, *(const a_hash_u64*)(bytePntr + 0));
+		acc2 = StdHashRound(acc2, *(const a_hash_u64*)(bytePntr + 8));
+		acc3 = StdHashRound(acc3, *(const a_hash_u64*)(bytePntr + 16));
+		acc4 = StdHashRound(acc4, *(const a_hash_u64*)(bytePntr + 24));
+	}
+	accumulators[0] = acc1; accumulators[1] = acc2; accumulators[2] = acc3; accumulators[3] = acc4;
+	return bytePntr;
+}
+
+static inline uint64_t StdHashMergeAccumulators(const uint64_t* accumulators)
+{
+	uint64_t hash = StdHashRotl(accumulators[0], 1) + StdHashRotl(accumulators[1], 7) + StdHashRotl(accumulators[2], 12) + StdHashRotl(accumulators[3], 18);
+	hash = StdHashMergeRound(hash, accumulators[0]);
+	hash = StdHashMergeRound(hash, accumulators[1]);
+	hash = StdHashMergeRound(hash, accumulators[2]);
+	hash = StdHashMergeRound(hash, accumulators[3]);
+	return hash;
+}
+
+// Mixes in the last 0-31 bytes and does the final avalanche
+static inline uint64_t StdHashFinalize(uint64_t hash, const uint8_t* bytePntr, size_t numBytesLeft)
+{
+	for (; numBytesLeft >= 8; numBytesLeft -= 8, bytePntr += 8)
+	{
+		hash ^= StdHashRound(0, *(const a_hash_u64*)bytePntr);
+		hash = (StdHashRotl(hash, 27) * STD_HASH_PRIME1) + STD_HASH_PRIME4;
+	}
+	if (numBytesLeft >= 4)
+	{
+		hash ^= (uint64_t)(*(const a_hash_u32*)bytePntr) * STD_HASH_PRIME1;
+		hash = (StdHashRotl(hash, 23) * STD_HASH_PRIME2) + STD_HASH_PRIME3;
+		numBytesLeft -= 4;
+		bytePntr += 4;
+	}
+	for (; numBytesLeft > 0; numBytesLeft--, bytePntr++)
+	{
+		hash ^= (*bytePntr) * STD_HASH_PRIME5;
+		hash = StdHashRotl(hash, 11) * STD_HASH_PRIME1;
+	}
+	
+	hash ^= (hash >> 33);
+	hash *= STD_HASH_PRIME2;
+	hash ^= (hash >> 29);
+	hash *= STD_HASH_PRIME3;
+	hash ^= (hash >> 32);
+	return hash;
+}
+
+uint64_t StdHash64(const void* dataPntr, size_t numBytes, uint64_t seed)
+{
+	const uint8_t* bytePntr = (const uint8_t*)dataPntr;
+	const uint8_t* endPntr = bytePntr + numBytes;
+	uint64_t hash;
+	if (numBytes >= STD_HASH_STRIPE_SIZE)
+	{
+		uint64_t accumulators[4];
+		StdHashInitAccumulators(accumulators, seed);
+		bytePntr = StdHashStripes(accumulators, bytePntr, endPntr);
+		hash = StdHashMergeAccumulators(accumulators);
+	}
+	else { hash = seed + STD_HASH_PRIME5; }
+	hash += (uint64_t)numBytes;
+	return StdHashFinalize(hash, bytePntr, endPntr - bytePntr);
+}
+
+uint64_t StdHashStr64(const char* nullTermStr, uint64_t seed)
+{
+	return StdHash64(nullTermStr, strlen(nullTermStr), seed);
+}
+
+// +--------------------------------------------------------------+
+// |                          Streaming                           |
+// +--------------------------------------------------------------+
+void StdHashStart(StdHashState_t* state, uint64_t seed)
+{
+	assert(state != nullptr);
+	state->totalNumBytes = 0;
+	state->seed = seed;
+	StdHashInitAccumulators(state->accumulators, seed);
+	state->bufferSize = 0;
+}
+
+// The data can be split up any way you like, the result from StdHashFinish is the same as StdHash64 on all the data at once
+void StdHashUpdate(StdHashState_t* state, const void* dataPntr, size_t numBytes)
+{
+	const uint8_t* bytePntr = (const uint8_t*)dataPntr;
+	const uint8_t* endPntr = bytePntr + numBytes;
+	state->totalNumBytes += numBytes;
+	
+	if (state->bufferSize > 0)
+	{
+		uint32_t numBytesToFill = STD_HASH_STRIPE_SIZE - state->bufferSize;
+		if (numBytes < numBytesToFill)
+		{
+			memcpy(&state->buffer[state->bufferSize], bytePntr, numBytes);
+			state->bufferSize += (uint32_t)numBytes;
+			return;
+		}
+		memcpy(&state->buffer[state->bufferSize], bytePntr, numBytesToFill);
+		StdHashStripes(state->accumulators, &state->buffer[0], &state->buffer[STD_HASH_STRIPE_SIZE]);
+		bytePntr += numBytesToFill;
+		state->bufferSize = 0;
+	}
+	
+	bytePntr = StdHashStripes(state->accumulators, bytePntr, endPntr);
+	if (bytePntr < endPntr)
+	{
+		memcpy(&state->buffer[0], bytePntr, endPntr - bytePntr);
+		state->bufferSize = (uint32_t)(endPntr - bytePntr);
+	}
+}
+
+// Doesn't modify the state, so more data can still be added afterwards
+uint64_t StdHashFinish(const StdHashState_t* state)
+{
+	uint64_t hash = ((state->totalNumBytes >= STD_HASH_STRIPE_SIZE) ? StdHashMergeAccumulators(state->accumulators) : (state->seed + STD_HASH_PRIME5));
+	hash += state->totalNumBytes;
+	return StdHashFinalize(hash, &state->buffer[0], state->bufferSize);
+}
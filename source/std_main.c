@@ -16,17 +16,30 @@ Description:
 #include "math.h"
 #include "stdlib.h"
 #include "string.h"
+#include "strings.h"
+#include "ctype.h"
 #include "stdbool.h"
 #include "stdarg.h"
 #include "intrin.h"
 #include "stdio.h"
+#include "std_arena.h"
+#include "std_heap_profiler.h"
+#include "std_stack.h"
+#include "std_hash.h"
+#include "std_utf.h"
+#include <internal/std_simd.h>
 
 #include "std_wasm_memory.c"
+#include "std_arena.c"
+#include "std_stack.c"
 
 #include "assert.c"
 #include "stdlib.c"
 #include "math.c"
+#include "ctype.c"
 #include "string.c"
+#include "std_hash.c"
+#include "std_utf.c"
 #include "intrin.c"
 #include "stdio.c"
 
@@ -35,5 +48,6 @@ Description:
 // +==============================+
 WASM_EXPORTED_FUNC(void, InitStdLib, uint32_t initialMemPageCount)
 {
+	InitStdStack();
 	InitWasmMemory(initialMemPageCount);
 }
@@ -0,0 +1,60 @@
+/*
+File:   std_new.cpp
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Holds the implementations for the operator new/delete overloads declared in <new>
+	** This has to be compiled as C++ so it can't be included in std_main.c, compile it alongside std_main.c instead (see build.bat)
+	** NOTE: We don't support exceptions, so instead of throwing std::bad_alloc the throwing forms of new abort
+*/
+
+#include <internal/std_common.h>
+#include "stdint.h"
+#include "stdbool.h"
+#include "new"
+
+CONDITIONAL_EXTERN_C_START
+void* WasmHeapAllocate(uint32_t numBytes);
+void* WasmHeapAllocateAligned(uint32_t numBytes, uint32_t alignment);
+void WasmHeapFree(void* allocPntr);
+void WasmHeapFreeSized(void* allocPntr, uint32_t numBytes, uint32_t alignment);
+CONDITIONAL_EXTERN_C_END
+
+const std::nothrow_t std::nothrow{};
+
+static inline void* StdNewCheckResult(void* result, size_t numBytes)
+{
+	if (result == nullptr) { jsStdAbort("operator new failed to allocate memory!", (int)numBytes); }
+	return result;
+}
+
+// +--------------------------------------------------------------+
+// |                             new                              |
+// +--------------------------------------------------------------+
+void* operator new(size_t numBytes)   { return StdNewCheckResult(WasmHeapAllocate((uint32_t)numBytes), numBytes); }
+void* operator new[](size_t numBytes) { return StdNewCheckResult(WasmHeapAllocate((uint32_t)numBytes), numBytes); }
+void* operator new(size_t numBytes, const std::nothrow_t&) noexcept   { return WasmHeapAllocate((uint32_t)numBytes); }
+void* operator new[](size_t numBytes, const std::nothrow_t&) noexcept { return WasmHeapAllocate((uint32_t)numBytes); }
+
+void* operator new(size_t numBytes, std::align_val_t alignment)   { return StdNewCheckResult(WasmHeapAllocateAligned((uint32_t)numBytes, (uint32_t)alignment), numBytes); }
+void* operator new[](size_t numBytes, std::align_val_t alignment) { return StdNewCheckResult(WasmHeapAllocateAligned((uint32_t)numBytes, (uint32_t)alignment), numBytes); }
+void* operator new(size_t numBytes, std::align_val_t alignment, const std::nothrow_t&) noexcept   { return WasmHeapAllocateAligned((uint32_t)numBytes, (uint32_t)alignment); }
+void* operator new[](size_t numBytes, std::align_val_t alignment, const std::nothrow_t&) noexcept { return WasmHeapAllocateAligned((uint32_t)numBytes, (uint32_t)alignment); }
+
+// +--------------------------------------------------------------+
+// |                            delete                            |
+// +--------------------------------------------------------------+
+void operator delete(void* allocPntr) noexcept   { WasmHeapFree(allocPntr); }
+void operator delete[](void* allocPntr) noexcept { WasmHeapFree(allocPntr); }
+void operator delete(void* allocPntr, const std::nothrow_t&) noexcept   { WasmHeapFree(allocPntr); }
+void operator delete[](void* allocPntr, const std::nothrow_t&) noexcept { WasmHeapFree(allocPntr); }
+void operator delete(void* allocPntr, std::align_val_t alignment) noexcept   { WasmHeapFree(allocPntr); }
+void operator delete[](void* allocPntr, std::align_val_t alignment) noexcept { WasmHeapFree(allocPntr); }
+void operator delete(void* allocPntr, std::align_val_t alignment, const std::nothrow_t&) noexcept   { WasmHeapFree(allocPntr); }
+void operator delete[](void* allocPntr, std::align_val_t alignment, const std::nothrow_t&) noexcept { WasmHeapFree(allocPntr); }
+
+// The compiler passes the same size that was given to new (including the array cookie for new[]) so these can go straight to the right allocator
+void operator delete(void* allocPntr, size_t numBytes) noexcept   { WasmHeapFreeSized(allocPntr, (uint32_t)numBytes, 0); }
+void operator delete[](void* allocPntr, size_t numBytes) noexcept { WasmHeapFreeSized(allocPntr, (uint32_t)numBytes, 0); }
+void operator delete(void* allocPntr, size_t numBytes, std::align_val_t alignment) noexcept   { WasmHeapFreeSized(allocPntr, (uint32_t)numBytes, (uint32_t)alignment); }
+void operator delete[](void* allocPntr, size_t numBytes, std::align_val_t alignment) noexcept { WasmHeapFreeSized(allocPntr, (uint32_t)numBytes, (uint32_t)alignment); }
@@ -0,0 +1,70 @@
+/*
+File:   std_stack.c
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Holds all the implementations for functions declared in std_stack.h
+	** NOTE: This assumes wasm-ld's default layout where the stack sits between the data section and the heap
+	**       (__data_end up to __heap_base) and grows down towards __data_end. Linking with --stack-first is not supported
+*/
+
+// The space below the current stack pointer that InitStdStack leaves alone, so painting never touches
+// anything the function calling InitStdStack (or InitStdStack itself) might have spilled to the stack
+#define STD_STACK_PAINT_MARGIN 256
+
+extern unsigned char __data_end;
+
+uint32_t StdStackBaseAddress = 0; //lowest address the stack can grow down to
+uint32_t StdStackTopAddress = 0; //the stack pointer starts here (this is also where the heap starts)
+
+static inline uint32_t StdStackGetPointer()
+{
+	volatile uint32_t localVariable = 0;
+	return (uint32_t)&localVariable;
+}
+
+void InitStdStack()
+{
+	StdStackBaseAddress = (((uint32_t)&__data_end + 15) & ~15);
+	StdStackTopAddress = (uint32_t)&__heap_base;
+	assert(StdStackBaseAddress <= StdStackTopAddress);
+	
+	uint32_t paintEnd = StdStackGetPointer() - STD_STACK_PAINT_MARGIN;
+	for (uint32_t address = StdStackBaseAddress; address + sizeof(uint32_t) <= paintEnd; address += sizeof(uint32_t))
+	{
+		*((volatile uint32_t*)address) = STD_STACK_PAINT_VALUE;
+	}
+}
+
+uint32_t StdStackGetSize()
+{
+	return StdStackTopAddress - StdStackBaseAddress;
+}
+
+// How much of the stack is in use right now (by the caller and everyone above it)
+uint32_t StdStackGetUsed()
+{
+	return StdStackTopAddress - StdStackGetPointer();
+}
+
+// The most stack that has been in use at once since InitStdLib, found by scanning up from the bottom of the stack
+// for the first word that no longer holds STD_STACK_PAINT_VALUE. This is linear in the amount of stack that was never touched
+// uint32_t StdStackGetHighWaterMark()
+WASM_EXPORTED_FUNC(uint32_t, StdStackGetHighWaterMark)
+{
+	uint32_t address = StdStackBaseAddress;
+	while (address < StdStackTopAddress && *((volatile uint32_t*)address) == STD_STACK_PAINT_VALUE) { address += sizeof(uint32_t); }
+	return StdStackTopAddress - address;
+}
+
+// Called through the alloca macro in stdlib.h (when STD_ALLOCA_CHECK_ENABLED) before the stack pointer is moved.
+// Checking up front means a huge numBytes can't wrap the stack pointer around into the top of memory
+size_t StdStackCheckAlloca(size_t numBytes)
+{
+	uint32_t stackPntr = StdStackGetPointer();
+	if (stackPntr < StdStackBaseAddress || numBytes > stackPntr - StdStackBaseAddress)
+	{
+		jsStdAbort("alloca overflowed the stack! Increase StackSize in build.bat or allocate this on the heap instead", (int)numBytes);
+	}
+	return numBytes;
+}
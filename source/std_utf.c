@@ -0,0 +1,443 @@
+/*
+File:   std_utf.c
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Holds all the implementations for functions declared in std_utf.h
+	** NOTE: Most text is ASCII, so every function first checks if the next 16 bytes (or units) are all ASCII and handles
+	**       them in one step (with SIMD128 when it's enabled, otherwise 8 bytes at a time with 64-bit words).
+	**       With SIMD, StdUtf8Validate checks every block with the lookup algorithm from simdjson/simdutf
+	**       (Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte")
+*/
+
+typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) a_utf_u64;
+
+// +--------------------------------------------------------------+
+// |                        Scalar Helpers                        |
+// +--------------------------------------------------------------+
+// Decodes the sequence at the start of str and returns the number of bytes it used, or 0 if the sequence is invalid
+// (a stray continuation byte, cut off, overlong, a surrogate or above U+10FFFF)
+static inline uint32_t StdUtf8Decode(const uint8_t* str, size_t numBytesLeft, uint32_t* codepointOut)
+{
+	uint8_t firstByte = str[0];
+	if (firstByte < 0x80) { *codepointOut = firstByte; return 1; }
+	else if (firstByte < 0xC2) { return 0; }
+	else if (firstByte < 0xE0)
+	{
+		if (numBytesLeft < 2 || (str[1] & 0xC0) != 0x80) { return 0; }
+		*codepointOut = ((uint32_t)(firstByte & 0x1F) << 6) | (str[1] & 0x3F);
+		return 2;
+	}
+	else if (firstByte < 0xF0)
+	{
+		if (numBytesLeft < 3 || (str[1] & 0xC0) != 0x80 || (str[2] & 0xC0) != 0x80) { return 0; }
+		if (firstByte == 0xE0 && str[1] < 0xA0) { return 0; } //overlong
+		if (firstByte == 0xED && str[1] >= 0xA0) { return 0; } //surrogate
+		*codepointOut = ((uint32_t)(firstByte & 0x0F) << 12) | ((uint32_t)(str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+		return 3;
+	}
+	else if (firstByte < 0xF5)
+	{
+		if (numBytesLeft < 4 || (str[1] & 0xC0) != 0x80 || (str[2] & 0xC0) != 0x80 || (str[3] & 0xC0) != 0x80) { return 0; }
+		if (firstByte == 0xF0 && str[1] < 0x90) { return 0; } //overlong
+		if (firstByte == 0xF4 && str[1] >= 0x90) { return 0; } //above U+10FFFF
+		*codepointOut = ((uint32_t)(firstByte & 0x07) << 18) | ((uint32_t)(str[1] & 0x3F) << 12) | ((uint32_t)(str[2] & 0x3F) << 6) | (str[3] & 0x3F);
+		return 4;
+	}
+	else { return 0; }
+}
+
+// codepoint must already be known to be valid, returns the number of bytes written
+static inline uint32_t StdUtf8Encode(uint32_t codepoint, uint8_t* bufferOut)
+{
+	if (codepoint < 0x80) { bufferOut[0] = (uint8_t)codepoint; return 1; }
+	else if (codepoint < 0x800)
+	{
+		bufferOut[0] = (uint8_t)(0xC0 | (codepoint >> 6));
+		bufferOut[1] = (uint8_t)(0x80 | (codepoint & 0x3F));
+		return 2;
+	}
+	else if (codepoint < 0x10000)
+	{
+		bufferOut[0] = (uint8_t)(0xE0 | (codepoint >> 12));
+		bufferOut[1] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+		bufferOut[2] = (uint8_t)(0x80 | (codepoint & 0x3F));
+		return 3;
+	}
+	else
+	{
+		bufferOut[0] = (uint8_t)(0xF0 | (codepoint >> 18));
+		bufferOut[1] = (uint8_t)(0x80 | ((codepoint >> 12) & 0x3F));
+		bufferOut[2] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+		bufferOut[3] = (uint8_t)(0x80 | (codepoint & 0x3F));
+		return 4;
+	}
+}
+
+// +--------------------------------------------------------------+
+// |                       ASCII Fast Path                        |
+// +--------------------------------------------------------------+
+// All of these need at least 16 bytes/units left in str. The Narrow functions check and convert in one go and
+// return false (without writing anything) if any of the 16 units isn't ASCII
+static inline bool StdUtfIsAscii16(const uint8_t* str)
+{
+	#if STD_SIMD_ENABLED
+	return (StdSimdMask((StdI8x16_t)*(const StdU8x16U_t*)str) == 0);
+	#else
+	return (((((const a_utf_u64*)str)[0] | ((const a_utf_u64*)str)[1]) & 0x8080808080808080ULL) == 0);
+	#endif
+}
+
+static inline void StdUtfWidenAscii16To16(const uint8_t* str, uint16_t* bufferOut)
+{
+	#if STD_SIMD_ENABLED
+	StdU8x16_t input = *(const StdU8x16U_t*)str;
+	StdU8x16_t zero = StdSimdSplatU8(0);
+	*(StdU8x16U_t*)&bufferOut[0] = __builtin_shufflevector(input, zero, 0, 16, 1, 16, 2, 16, 3, 16, 4, 16, 5, 16, 6, 16, 7, 16);
+	*(StdU8x16U_t*)&bufferOut[8] = __builtin_shufflevector(input, zero, 8, 16, 9, 16, 10, 16, 11, 16, 12, 16, 13, 16, 14, 16, 15, 16);
+	#else
+	for (uint32_t bIndex = 0; bIndex < 16; bIndex++) { bufferOut[bIndex] = str[bIndex]; }
+	#endif
+}
+
+static inline void StdUtfWidenAscii16To32(const uint8_t* str, uint32_t* bufferOut)
+{
+	#if STD_SIMD_ENABLED
+	StdU8x16_t input = *(const StdU8x16U_t*)str;
+	StdU8x16_t zero = StdSimdSplatU8(0);
+	*(StdU8x16U_t*)&bufferOut[0] = __builtin_shufflevector(input, zero, 0, 16, 16, 16, 1, 16, 16, 16, 2, 16, 16, 16, 3, 16, 16, 16);
+	*(StdU8x16U_t*)&bufferOut[4] = __builtin_shufflevector(input, zero, 4, 16, 16, 16, 5, 16, 16, 16, 6, 16, 16, 16, 7, 16, 16, 16);
+	*(StdU8x16U_t*)&bufferOut[8] = __builtin_shufflevector(input, zero, 8, 16, 16, 16, 9, 16, 16, 16, 10, 16, 16, 16, 11, 16, 16, 16);
+	*(StdU8x16U_t*)&bufferOut[12] = __builtin_shufflevector(input, zero, 12, 16, 16, 16, 13, 16, 16, 16, 14, 16, 16, 16, 15, 16, 16, 16);
+	#else
+	for (uint32_t bIndex = 0; bIndex < 16; bIndex++) { bufferOut[bIndex] = str[bIndex]; }
+	#endif
+}
+
+static inline bool StdUtfNarrowAscii16From16(const uint16_t* str, uint8_t* bufferOut)
+{
+	#if STD_SIMD_ENABLED
+	StdU16x8U_t firstHalf = *(const StdU16x8U_t*)&str[0];
+	StdU16x8U_t secondHalf = *(const StdU16x8U_t*)&str[8];
+	if (StdSimdMask((StdI8x16_t)(((firstHalf | secondHalf) & 0xFF80) != 0)) != 0) { return false; }
+	*(StdU8x16U_t*)bufferOut = __builtin_shufflevector((StdU8x16_t)firstHalf, (StdU8x16_t)secondHalf, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+	#else
+	const a_utf_u64* wordPntr = (const a_utf_u64*)str;
+	if (((wordPntr[0] | wordPntr[1] | wordPntr[2] | wordPntr[3]) & 0xFF80FF80FF80FF80ULL) != 0) { return false; }
+	for (uint32_t uIndex = 0; uIndex < 16; uIndex++) { bufferOut[uIndex] = (uint8_t)str[uIndex]; }
+	#endif
+	return true;
+}
+
+static inline bool StdUtfNarrowAscii16From32(const uint32_t* str, uint8_t* bufferOut)
+{
+	#if STD_SIMD_ENABLED
+	StdU32x4U_t quarter0 = *(const StdU32x4U_t*)&str[0];
+	StdU32x4U_t quarter1 = *(const StdU32x4U_t*)&str[4];
+	StdU32x4U_t quarter2 = *(const StdU32x4U_t*)&str[8];
+	StdU32x4U_t quarter3 = *(const StdU32x4U_t*)&str[12];
+	if (StdSimdMask((StdI8x16_t)(((quarter0 | quarter1 | quarter2 | quarter3) & 0xFFFFFF80) != 0)) != 0) { return false; }
+	StdU8x16_t firstHalf = __builtin_shufflevector((StdU8x16_t)quarter0, (StdU8x16_t)quarter1, 0, 4, 8, 12, 16, 20, 24, 28, 0, 0, 0, 0, 0, 0, 0, 0);
+	StdU8x16_t secondHalf = __builtin_shufflevector((StdU8x16_t)quarter2, (StdU8x16_t)quarter3, 0, 4, 8, 12, 16, 20, 24, 28, 0, 0, 0, 0, 0, 0, 0, 0);
+	*(StdU8x16U_t*)bufferOut = __builtin_shufflevector(firstHalf, secondHalf, 0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23);
+	#else
+	const a_utf_u64* wordPntr = (const a_utf_u64*)str;
+	uint64_t allBits = 0;
+	for (uint32_t wIndex = 0; wIndex < 8; wIndex++) { allBits |= wordPntr[wIndex]; }
+	if ((allBits & 0xFFFFFF80FFFFFF80ULL) != 0) { return false; }
+	for (uint32_t uIndex = 0; uIndex < 16; uIndex++) { bufferOut[uIndex] = (uint8_t)str[uIndex]; }
+	#endif
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                          Validation                          |
+// +--------------------------------------------------------------+
+#if STD_SIMD_ENABLED
+// Each table looks up a nibble (the high or low nibble of the previous byte, or the high nibble of the current byte) and gives
+// the set of errors that byte pair could be part of. A pair is only an error if all three lookups agree on at least one bit
+#define STD_UTF8_TOO_SHORT      (1<<0) //11______ 0_______ or 11______ 11______
+#define STD_UTF8_TOO_LONG       (1<<1) //0_______ 10______
+#define STD_UTF8_OVERLONG_3     (1<<2) //11100000 100_____
+#define STD_UTF8_TOO_LARGE      (1<<3) //11110100 1001____, 11110100 101_____, 11110101 1001____, 1111011_ 1001____, 11111___ 1001____ etc.
+#define STD_UTF8_SURROGATE      (1<<4) //11101101 101_____
+#define STD_UTF8_OVERLONG_2     (1<<5) //1100000_ 10______
+#define STD_UTF8_TOO_LARGE_1000 (1<<6) //11110100 1000____ (and 11110101+ 1000____)
+#define STD_UTF8_OVERLONG_4     (1<<6) //11110000 1000____
+#define STD_UTF8_TWO_CONTS      (1<<7) //10______ 10______ (fine if it's the 3rd or 4th byte of a sequence, see below)
+#define STD_UTF8_CARRY          (STD_UTF8_TOO_SHORT | STD_UTF8_TOO_LONG | STD_UTF8_TWO_CONTS)
+
+// Returns a non-zero lane for every byte in input that is part of an invalid sequence. prevInput is the previous 16 bytes
+static inline StdU8x16_t StdUtf8CheckBlock(StdU8x16_t input, StdU8x16_t prevInput)
+{
+	const StdU8x16_t byte1HighTable = {
+		STD_UTF8_TOO_LONG, STD_UTF8_TOO_LONG, STD_UTF8_TOO_LONG, STD_UTF8_TOO_LONG,
+		STD_UTF8_TOO_LONG, STD_UTF8_TOO_LONG, STD_UTF8_TOO_LONG, STD_UTF8_TOO_LONG,
+		STD_UTF8_TWO_CONTS, STD_UTF8_TWO_CONTS, STD_UTF8_TWO_CONTS, STD_UTF8_TWO_CONTS,
+		STD_UTF8_TOO_SHORT | STD_UTF8_OVERLONG_2,
+		STD_UTF8_TOO_SHORT,
+		STD_UTF8_TOO_SHORT | STD_UTF8_OVERLONG_3 | STD_UTF8_SURROGATE,
+		STD_UTF8_TOO_SHORT | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000 | STD_UTF8_OVERLONG_4,
+	};
+	const StdU8x16_t byte1LowTable = {
+		STD_UTF8_CARRY | STD_UTF8_OVERLONG_3 | STD_UTF8_OVERLONG_2 | STD_UTF8_OVERLONG_4,
+		STD_UTF8_CARRY | STD_UTF8_OVERLONG_2,
+		STD_UTF8_CARRY,
+		STD_UTF8_CARRY,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000 | STD_UTF8_SURROGATE,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+		STD_UTF8_CARRY | STD_UTF8_TOO_LARGE | STD_UTF8_TOO_LARGE_1000,
+	};
+	const StdU8x16_t byte2HighTable = {
+		STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT,
+		STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT,
+		STD_UTF8_TOO_LONG | STD_UTF8_OVERLONG_2 | STD_UTF8_TWO_CONTS | STD_UTF8_OVERLONG_3 | STD_UTF8_TOO_LARGE_1000 | STD_UTF8_OVERLONG_4,
+		STD_UTF8_TOO_LONG | STD_UTF8_OVERLONG_2 | STD_UTF8_TWO_CONTS | STD_UTF8_OVERLONG_3 | STD_UTF8_TOO_LARGE,
+		STD_UTF8_TOO_LONG | STD_UTF8_OVERLONG_2 | STD_UTF8_TWO_CONTS | STD_UTF8_SURROGATE | STD_UTF8_TOO_LARGE,
+		STD_UTF8_TOO_LONG | STD_UTF8_OVERLONG_2 | STD_UTF8_TWO_CONTS | STD_UTF8_SURROGATE | STD_UTF8_TOO_LARGE,
+		STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT, STD_UTF8_TOO_SHORT,
+	};
+	
+	// The input shifted "right" by 1, 2 and 3 bytes with the end of the previous block shifted in
+	StdU8x16_t prev1 = __builtin_shufflevector(prevInput, input, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30);
+	StdU8x16_t prev2 = __builtin_shufflevector(prevInput, input, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29);
+	StdU8x16_t prev3 = __builtin_shufflevector(prevInput, input, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28);
+	
+	StdU8x16_t specialCases = (StdSimdSwizzle(byte1HighTable, (prev1 >> 4)) & StdSimdSwizzle(byte1LowTable, (prev1 & 0x0F)) & StdSimdSwizzle(byte2HighTable, (input >> 4)));
+	// Two continuation bytes in a row is only allowed if the first byte of the sequence was 2 or 3 bytes back
+	StdU8x16_t mustBeContinuation = ((StdU8x16_t)((prev2 >= 0xE0) | (prev3 >= 0xF0)) & 0x80);
+	return (mustBeContinuation ^ specialCases);
+}
+#endif //STD_SIMD_ENABLED
+
+bool StdUtf8Validate(const char* str, size_t numBytes)
+{
+	const uint8_t* bytePntr = (const uint8_t*)str;
+	#if STD_SIMD_ENABLED
+	// Pure ASCII blocks skip the lookups, they only need to check that the block before didn't end in the middle of a sequence
+	const StdU8x16_t incompleteLimits = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0-1, 0xE0-1, 0xC0-1 };
+	StdU8x16_t zero = StdSimdSplatU8(0);
+	StdU8x16_t errors = zero;
+	StdU8x16_t prevInput = zero;
+	StdU8x16_t prevIncomplete = zero;
+	size_t bIndex = 0;
+	for (; bIndex + STD_SIMD_SIZE <= numBytes; bIndex += STD_SIMD_SIZE)
+	{
+		StdU8x16_t input = *(const StdU8x16U_t*)&bytePntr[bIndex];
+		if (StdSimdMask((StdI8x16_t)input) == 0)
+		{
+			errors |= prevIncomplete;
+			prevIncomplete = zero;
+		}
+		else
+		{
+			errors |= StdUtf8CheckBlock(input, prevInput);
+			prevIncomplete = (StdU8x16_t)(input > incompleteLimits);
+		}
+		prevInput = input;
+	}
+	// The last 0-15 bytes are checked in a zero padded block. The zeros after the end also catch a sequence that's been
+	// cut off, whether it started in this block or the one before
+	StdU8x16_t lastInput = zero;
+	memcpy(&lastInput, &bytePntr[bIndex], numBytes - bIndex);
+	errors |= StdUtf8CheckBlock(lastInput, prevInput);
+	return (StdSimdMask((StdI8x16_t)(errors != 0)) == 0);
+	#else
+	const uint8_t* endPntr = bytePntr + numBytes;
+	while (bytePntr < endPntr)
+	{
+		if (*bytePntr < 0x80)
+		{
+			if (endPntr - bytePntr >= 16 && StdUtfIsAscii16(bytePntr)) { bytePntr += 16; }
+			else { bytePntr++; }
+			continue;
+		}
+		uint32_t codepoint;
+		uint32_t sequenceLength = StdUtf8Decode(bytePntr, endPntr - bytePntr, &codepoint);
+		if (sequenceLength == 0) { return false; }
+		bytePntr += sequenceLength;
+	}
+	return true;
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                           Lengths                            |
+// +--------------------------------------------------------------+
+// Every byte that isn't a continuation byte (10xxxxxx) starts a codepoint, and every 4 byte sequence (11110xxx) needs a surrogate pair
+static inline size_t StdUtf8CountBytes(const uint8_t* str, size_t numBytes, bool countFourByteLeads)
+{
+	size_t result = 0;
+	size_t bIndex = 0;
+	#if STD_SIMD_ENABLED
+	for (; bIndex + STD_SIMD_SIZE <= numBytes; bIndex += STD_SIMD_SIZE)
+	{
+		StdU8x16_t input = *(const StdU8x16U_t*)&str[bIndex];
+		result += __builtin_popcount(StdSimdMask((StdI8x16_t)input > -65)); //0x80-0xBF are -128 to -65
+		if (countFourByteLeads) { result += __builtin_popcount(StdSimdMask(input >= 0xF0)); }
+	}
+	#endif
+	for (; bIndex < numBytes; bIndex++)
+	{
+		if ((str[bIndex] & 0xC0) != 0x80) { result++; }
+		if (countFourByteLeads && str[bIndex] >= 0xF0) { result++; }
+	}
+	return result;
+}
+
+size_t StdUtf16LengthFromUtf8(const char* str, size_t numBytes)
+{
+	return StdUtf8CountBytes((const uint8_t*)str, numBytes, true);
+}
+size_t StdUtf32LengthFromUtf8(const char* str, size_t numBytes)
+{
+	return StdUtf8CountBytes((const uint8_t*)str, numBytes, false);
+}
+
+size_t StdUtf8LengthFromUtf16(const uint16_t* str, size_t numUnits)
+{
+	size_t result = 0;
+	for (size_t uIndex = 0; uIndex < numUnits; uIndex++)
+	{
+		uint16_t unit = str[uIndex];
+		if (unit < 0x80) { result += 1; }
+		else if (unit < 0x800) { result += 2; }
+		else if (unit >= 0xD800 && unit < 0xE000) { result += 2; } //each half of a surrogate pair makes up half of a 4 byte sequence
+		else { result += 3; }
+	}
+	return result;
+}
+
+size_t StdUtf8LengthFromUtf32(const uint32_t* str, size_t numUnits)
+{
+	size_t result = 0;
+	for (size_t uIndex = 0; uIndex < numUnits; uIndex++)
+	{
+		uint32_t codepoint = str[uIndex];
+		result += ((codepoint < 0x80) ? 1 : ((codepoint < 0x800) ? 2 : ((codepoint < 0x10000) ? 3 : 4)));
+	}
+	return result;
+}
+
+// +--------------------------------------------------------------+
+// |                         Conversions                          |
+// +--------------------------------------------------------------+
+size_t StdUtf8ToUtf16(const char* str, size_t numBytes, uint16_t* bufferOut)
+{
+	const uint8_t* bytePntr = (const uint8_t*)str;
+	const uint8_t* endPntr = bytePntr + numBytes;
+	uint16_t* outPntr = bufferOut;
+	while (bytePntr < endPntr)
+	{
+		if (*bytePntr < 0x80)
+		{
+			if (endPntr - bytePntr >= 16 && StdUtfIsAscii16(bytePntr))
+			{
+				StdUtfWidenAscii16To16(bytePntr, outPntr);
+				bytePntr += 16;
+				outPntr += 16;
+			}
+			else { *outPntr++ = *bytePntr++; }
+			continue;
+		}
+		uint32_t codepoint;
+		uint32_t sequenceLength = StdUtf8Decode(bytePntr, endPntr - bytePntr, &codepoint);
+		if (sequenceLength == 0) { return STD_UTF_INVALID; }
+		bytePntr += sequenceLength;
+		if (codepoint >= 0x10000)
+		{
+			codepoint -= 0x10000;
+			*outPntr++ = (uint16_t)(0xD800 | (codepoint >> 10));
+			*outPntr++ = (uint16_t)(0xDC00 | (codepoint & 0x3FF));
+		}
+		else { *outPntr++ = (uint16_t)codepoint; }
+	}
+	return (outPntr - bufferOut);
+}
+
+size_t StdUtf8ToUtf32(const char* str, size_t numBytes, uint32_t* bufferOut)
+{
+	const uint8_t* bytePntr = (const uint8_t*)str;
+	const uint8_t* endPntr = bytePntr + numBytes;
+	uint32_t* outPntr = bufferOut;
+	while (bytePntr < endPntr)
+	{
+		if (*bytePntr < 0x80)
+		{
+			if (endPntr - bytePntr >= 16 && StdUtfIsAscii16(bytePntr))
+			{
+				StdUtfWidenAscii16To32(bytePntr, outPntr);
+				bytePntr += 16;
+				outPntr += 16;
+			}
+			else { *outPntr++ = *bytePntr++; }
+			continue;
+		}
+		uint32_t sequenceLength = StdUtf8Decode(bytePntr, endPntr - bytePntr, outPntr);
+		if (sequenceLength == 0) { return STD_UTF_INVALID; }
+		bytePntr += sequenceLength;
+		outPntr++;
+	}
+	return (outPntr - bufferOut);
+}
+
+// Unpaired surrogates are treated as invalid
+size_t StdUtf16ToUtf8(const uint16_t* str, size_t numUnits, char* bufferOut)
+{
+	uint8_t* outPntr = (uint8_t*)bufferOut;
+	size_t uIndex = 0;
+	while (uIndex < numUnits)
+	{
+		if (str[uIndex] < 0x80)
+		{
+			if (numUnits - uIndex >= 16 && StdUtfNarrowAscii16From16(&str[uIndex], outPntr))
+			{
+				uIndex += 16;
+				outPntr += 16;
+			}
+			else { *outPntr++ = (uint8_t)str[uIndex++]; }
+			continue;
+		}
+		uint32_t codepoint = str[uIndex++];
+		if (codepoint >= 0xD800 && codepoint < 0xE000)
+		{
+			if (codepoint >= 0xDC00 || uIndex >= numUnits || str[uIndex] < 0xDC00 || str[uIndex] >= 0xE000) { return STD_UTF_INVALID; }
+			codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (str[uIndex++] - 0xDC00);
+		}
+		outPntr += StdUtf8Encode(codepoint, outPntr);
+	}
+	return (outPntr - (uint8_t*)bufferOut);
+}
+
+// Surrogates and values above U+10FFFF are treated as invalid
+size_t StdUtf32ToUtf8(const uint32_t* str, size_t numUnits, char* bufferOut)
+{
+	uint8_t* outPntr = (uint8_t*)bufferOut;
+	size_t uIndex = 0;
+	while (uIndex < numUnits)
+	{
+		if (str[uIndex] < 0x80)
+		{
+			if (numUnits - uIndex >= 16 && StdUtfNarrowAscii16From32(&str[uIndex], outPntr))
+			{
+				uIndex += 16;
+				outPntr += 16;
+			}
+			else { *outPntr++ = (uint8_t)str[uIndex++]; }
+			continue;
+		}
+		uint32_t codepoint = str[uIndex++];
+		if (codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint < 0xE000)) { return STD_UTF_INVALID; }
+		outPntr += StdUtf8Encode(codepoint, outPntr);
+	}
+	return (outPntr - (uint8_t*)bufferOut);
+}
@@ -4,15 +4,241 @@ Author: Taylor Robbins
 Date:   10\07\2023
 Description: 
 	** Handles keeping track of the memory used by the web assembly module
-	** Wasm memory is only allowed to grow, never shrink, and it grows in 4kB pages
+	** Wasm memory is only allowed to grow, never shrink, and it grows in 64kB pages
+	** We grow the memory ourselves with memory.grow and let javascript know afterwards through jsStdMemoryGrown
+	** On top of the page/bump logic we run a TLSF (Two-Level Segregated Fit) heap that backs malloc/free/realloc/calloc.
+	** Free blocks are binned by a first-level (power of 2) and second-level (linear subdivision) index and
+	** a pair of bitmaps lets us find a suitable bin in O(1). Neighboring free blocks are always coalesced.
+	** Allocations of WASM_SLAB_MAX_SIZE or less skip TLSF entirely and are served from per-size-class slab pages
 */
 
+// +--------------------------------------------------------------+
+// |                           Defines                            |
+// +--------------------------------------------------------------+
+// Thread safe mode is needed when the module is built with -matomics and shared memory so worker threads can allocate.
+// The bump pointer becomes atomic, each thread gets it's own slab pages and the TLSF heap gets a spinlock
+#ifndef WASM_HEAP_THREAD_SAFE
+#ifdef __wasm_atomics__
+#define WASM_HEAP_THREAD_SAFE 1
+#else
+#define WASM_HEAP_THREAD_SAFE 0
+#endif
+#endif
+
+#if WASM_HEAP_THREAD_SAFE
+#define WASM_THREAD_LOCAL __thread
+#else
+#define WASM_THREAD_LOCAL //nothing
+#endif
+
+// These can be defined by the application to change the default growth policy (SetWasmMemoryGrowthPolicy can change them at runtime)
+#ifndef WASM_MEMORY_GROWTH_PERCENT
+#define WASM_MEMORY_GROWTH_PERCENT      25 //when we need more pages, grow by at least this percent of the current memory size
+#endif
+#ifndef WASM_MEMORY_MIN_GROW_NUM_PAGES
+#define WASM_MEMORY_MIN_GROW_NUM_PAGES  1
+#endif
+// Set this to 0 to compile out the counters in WasmMemoryStats (GetWasmMemoryStats will still walk the heap for the other values)
+// They are off by default in thread safe mode since every thread would be fighting over the same cache line
+#ifndef WASM_MEMORY_STATS_ENABLED
+#define WASM_MEMORY_STATS_ENABLED       (!WASM_HEAP_THREAD_SAFE)
+#endif
+// Set this to 1 to record a sample (with the current StdHeapProfilerSetTag tag) every WASM_HEAP_PROFILER_SAMPLE_INTERVAL bytes allocated
+#ifndef WASM_HEAP_PROFILER_ENABLED
+#define WASM_HEAP_PROFILER_ENABLED      0
+#endif
+#ifndef WASM_HEAP_PROFILER_SAMPLE_INTERVAL
+#define WASM_HEAP_PROFILER_SAMPLE_INTERVAL (64*1024) //can be changed at runtime with StdHeapProfilerSetInterval
+#endif
+#define WASM_HEAP_PROFILER_NUM_SAMPLES  4096 //size of the ring buffer, older samples get overwritten
+
+#define WASM_MEMORY_ALIGNMENT       16 //WasmMemoryAllocate always returns addresses aligned to this
+
+#define WASM_HEAP_ALIGNMENT_LOG2    4
+#define WASM_HEAP_ALIGNMENT         (1 << WASM_HEAP_ALIGNMENT_LOG2) //16 bytes, every pointer the TLSF heap returns is aligned to this
+#define WASM_HEAP_SL_COUNT_LOG2     5
+#define WASM_HEAP_SL_COUNT          (1 << WASM_HEAP_SL_COUNT_LOG2) //32 second-level bins per first-level bin
+#define WASM_HEAP_FL_SHIFT          (WASM_HEAP_SL_COUNT_LOG2 + WASM_HEAP_ALIGNMENT_LOG2)
+#define WASM_HEAP_FL_MAX            32 //blocks must be smaller than 1 << WASM_HEAP_FL_MAX
+#define WASM_HEAP_FL_COUNT          (WASM_HEAP_FL_MAX - WASM_HEAP_FL_SHIFT + 1)
+#define WASM_HEAP_SMALL_BLOCK_SIZE  (1 << WASM_HEAP_FL_SHIFT) //blocks smaller than this all live in first-level bin 0
+#define WASM_HEAP_MAX_ALLOC_SIZE    0x7FFFFFF0 //we can't grow past 2GB anyways
+#define WASM_HEAP_MIN_GROW_SIZE     WASM_MEMORY_PAGE_SIZE //when the heap runs out of space we ask the page logic for at least this much
+
+#define WASM_SLAB_MAX_SIZE          256 //allocations this size or smaller are served by the slab heap
+#define WASM_SLAB_NUM_CLASSES       16
+#define WASM_HEAP_NUM_STAT_CLASSES  (WASM_SLAB_NUM_CLASSES + 1) //one for each slab size class and one for everything that goes to the TLSF heap
+
+#define WASM_HEAP_FREE_FLAG         0x01 //this block is free
+#define WASM_HEAP_PREV_FREE_FLAG    0x02 //the block physically before this one is free (and prevPhysical is valid)
+#define WASM_HEAP_FLAGS_MASK        (WASM_HEAP_ALIGNMENT - 1)
+
+// +--------------------------------------------------------------+
+// |                          Structures                          |
+// +--------------------------------------------------------------+
+typedef struct WasmHeapBlock_t WasmHeapBlock_t;
+struct WasmHeapBlock_t
+{
+	WasmHeapBlock_t* prevPhysical; //only valid when WASM_HEAP_PREV_FREE_FLAG is set
+	uint32_t size; //total size of the block (including this header), lower bits are used for flags
+	
+	// These two only exist while the block is free (otherwise this is where the user's memory starts)
+	WasmHeapBlock_t* nextFree;
+	WasmHeapBlock_t* prevFree;
+};
+#define WASM_HEAP_HEADER_SIZE      __builtin_offsetof(WasmHeapBlock_t, nextFree) //prevPhysical + size
+#define WASM_HEAP_MIN_BLOCK_SIZE   ((sizeof(WasmHeapBlock_t) + (WASM_HEAP_ALIGNMENT-1)) & ~(WASM_HEAP_ALIGNMENT-1))
+// Blocks are placed at this offset from an aligned address so that the pointer after the header is aligned
+#define WASM_HEAP_BLOCK_ALIGN_OFFSET ((WASM_HEAP_ALIGNMENT - (WASM_HEAP_HEADER_SIZE % WASM_HEAP_ALIGNMENT)) % WASM_HEAP_ALIGNMENT)
+
+typedef struct WasmSlabPage_t WasmSlabPage_t;
+typedef struct WasmSlabThreadHeap_t WasmSlabThreadHeap_t;
+
+// Each thread has it's own set of slab pages so the common case never has to synchronize with other threads
+struct WasmSlabThreadHeap_t
+{
+	WasmSlabPage_t* partialPages[WASM_SLAB_NUM_CLASSES]; //pages that have at least one free block, per size class
+	#if WASM_HEAP_THREAD_SAFE
+	WasmSlabPage_t* remoteFreePages; //pages owned by this thread that other threads have freed blocks into
+	#endif
+};
+
+struct WasmSlabPage_t
+{
+	WasmSlabPage_t* next; //next page of the same size class that has free blocks (or next page in WasmSlabEmptyPages)
+	WasmSlabPage_t* prev;
+	void* freeList; //singly-linked list of freed blocks, the link is stored in the first 4 bytes of the block
+	uint32_t bumpOffset; //blocks at or past this offset have never been handed out
+	uint16_t classIndex;
+	uint16_t blockSize;
+	uint32_t numBlocks;
+	uint32_t numUsed;
+	#if WASM_HEAP_THREAD_SAFE
+	WasmSlabThreadHeap_t* owner; //only the owning thread touches the fields above, other threads push onto remoteFreeList
+	void* remoteFreeList;
+	WasmSlabPage_t* nextRemotePage; //link in owner->remoteFreePages
+	#endif
+};
+#define WASM_SLAB_HEADER_SIZE ((sizeof(WasmSlabPage_t) + 15) & ~15) //keep the first block 16-byte aligned
+
+// NOTE: This is read by PigWasm_GetMemoryStats in std_js_api.js, keep the two in sync!
+typedef struct WasmMemoryStats_t WasmMemoryStats_t;
+struct WasmMemoryStats_t
+{
+	uint32_t numPagesAllocated;
+	uint32_t numGrows; //number of times memory.grow was called
+	uint32_t liveBytes; //usable bytes in all allocations that haven't been freed yet
+	uint32_t peakLiveBytes;
+	uint32_t freeBytes; //bytes in free TLSF blocks and unused slab blocks
+	uint32_t largestFreeBlock; //largest allocation the TLSF heap can serve without growing
+	uint32_t fragmentedBytes; //free TLSF bytes that are not part of the largest free block
+	uint32_t overheadBytes; //TLSF block headers plus slab page headers and the unusable space at the end of slab pages
+	uint32_t alignmentWasteBytes; //bytes skipped over to align pools and pages that were too small to give to the heap
+	uint32_t numSizeClasses; //always WASM_HEAP_NUM_STAT_CLASSES, the last class is the TLSF heap
+	uint32_t allocCounts[WASM_HEAP_NUM_STAT_CLASSES];
+	uint32_t freeCounts[WASM_HEAP_NUM_STAT_CLASSES];
+};
+
+// NOTE: These are read by PigWasm_GetHeapProfile in std_js_api.js, keep them in sync!
+typedef struct WasmHeapProfilerSample_t WasmHeapProfilerSample_t;
+struct WasmHeapProfilerSample_t
+{
+	const char* tag; //whatever was last passed to StdHeapProfilerSetTag (or nullptr)
+	uint32_t allocSize; //the size of the allocation that happened to cross the sample boundary
+	uint32_t weight; //number of sample intervals this allocation crossed (a large allocation can cover more than one)
+};
+typedef struct WasmHeapProfilerInfo_t WasmHeapProfilerInfo_t;
+struct WasmHeapProfilerInfo_t
+{
+	WasmHeapProfilerSample_t* samples;
+	uint32_t maxNumSamples;
+	uint32_t numSamplesRecorded; //keeps counting past maxNumSamples, the next sample goes in samples[numSamplesRecorded % maxNumSamples]
+	uint32_t sampleInterval;
+};
+
+#if WASM_MEMORY_STATS_ENABLED && WASM_HEAP_THREAD_SAFE
+#define WasmMemoryStatAdd(fieldName, amount) __atomic_fetch_add(&WasmMemoryStats.fieldName, (amount), __ATOMIC_RELAXED)
+#define WasmMemoryStatSub(fieldName, amount) __atomic_fetch_sub(&WasmMemoryStats.fieldName, (amount), __ATOMIC_RELAXED)
+#define WasmMemoryStatUpdatePeak() do { uint32_t liveBytes_ = __atomic_load_n(&WasmMemoryStats.liveBytes, __ATOMIC_RELAXED); if (liveBytes_ > __atomic_load_n(&WasmMemoryStats.peakLiveBytes, __ATOMIC_RELAXED)) { __atomic_store_n(&WasmMemoryStats.peakLiveBytes, liveBytes_, __ATOMIC_RELAXED); } } while(0) //approximate
+#elif WASM_MEMORY_STATS_ENABLED
+#define WasmMemoryStatAdd(fieldName, amount) WasmMemoryStats.fieldName += (amount)
+#define WasmMemoryStatSub(fieldName, amount) WasmMemoryStats.fieldName -= (amount)
+#define WasmMemoryStatUpdatePeak() do { if (WasmMemoryStats.liveBytes > WasmMemoryStats.peakLiveBytes) { WasmMemoryStats.peakLiveBytes = WasmMemoryStats.liveBytes; } } while(0)
+#else
+#define WasmMemoryStatAdd(fieldName, amount) //nothing
+#define WasmMemoryStatSub(fieldName, amount) //nothing
+#define WasmMemoryStatUpdatePeak()           //nothing
+#endif
+
 // +--------------------------------------------------------------+
 // |                           Globals                            |
 // +--------------------------------------------------------------+
 uint32_t WasmMemoryHeapStartAddress = 0;
 uint32_t WasmMemoryHeapCurrentAddress = 0;
 uint32_t WasmMemoryNumPagesAllocated = 0;
+uint32_t WasmMemoryGrowthPercent = WASM_MEMORY_GROWTH_PERCENT;
+uint32_t WasmMemoryMinGrowNumPages = WASM_MEMORY_MIN_GROW_NUM_PAGES;
+uint32_t WasmMemoryMaxNumPages = WASM_MEMORY_MAX_NUM_PAGES;
+// Everything at or above this address is still zero, either because it came straight from memory.grow or because
+// nobody has written to it yet. Any code that writes to heap memory (or hands it to the user) must move this up first
+uint32_t WasmMemoryKnownZeroAddress = 0;
+
+uint32_t WasmHeapFirstLevelBitmap = 0;
+uint32_t WasmHeapSecondLevelBitmaps[WASM_HEAP_FL_COUNT];
+WasmHeapBlock_t* WasmHeapFreeLists[WASM_HEAP_FL_COUNT][WASM_HEAP_SL_COUNT];
+uint32_t WasmHeapTopPoolEnd = 0; //address right after the sentinel of the pool we created most recently
+
+#if WASM_HEAP_THREAD_SAFE
+uint32_t WasmHeapLockValue = 0; //protects the TLSF heap and WasmSlabEmptyPages
+uint32_t WasmMemoryGrowLockValue = 0; //protects WasmMemoryGrow, separate from WasmHeapLockValue since the heap grows while holding that
+#endif
+
+// Every class from 16 up is a multiple of 16 so those blocks are all 16-byte aligned (the first block starts at WASM_SLAB_HEADER_SIZE).
+// C requires malloc to return memory aligned for any type that fits, and long double needs 16 on wasm32
+static const uint16_t WasmSlabClassSizes[WASM_SLAB_NUM_CLASSES] = { 8, 16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 256 };
+static const uint8_t WasmSlabSizeToClass[(WASM_SLAB_MAX_SIZE/8) + 1] = //indexed by (numBytes+7)/8
+{
+	0, 0, 1, 2, 2, 3, 3, 4, 4,
+	5, 5, 6, 6, 7, 7, 8, 8,
+	9, 9, 10, 10, 11, 11, 12, 12,
+	13, 13, 14, 14, 15, 15, 15, 15,
+};
+WASM_THREAD_LOCAL WasmSlabThreadHeap_t WasmSlabThreadHeap;
+WasmSlabPage_t* WasmSlabEmptyPages = nullptr; //shared between all threads, protected by WasmHeapLock
+uint32_t WasmSlabPageBitmap[WASM_MEMORY_MAX_NUM_PAGES / 32]; //1 bit per wasm page, set if the page belongs to the slab heap
+
+WasmMemoryStats_t WasmMemoryStats;
+
+#if WASM_HEAP_PROFILER_ENABLED
+WasmHeapProfilerSample_t WasmHeapProfilerSamples[WASM_HEAP_PROFILER_NUM_SAMPLES];
+WasmHeapProfilerInfo_t WasmHeapProfilerInfo = { WasmHeapProfilerSamples, WASM_HEAP_PROFILER_NUM_SAMPLES, 0, WASM_HEAP_PROFILER_SAMPLE_INTERVAL };
+WASM_THREAD_LOCAL uint32_t WasmHeapProfilerBytesUntilSample = WASM_HEAP_PROFILER_SAMPLE_INTERVAL;
+WASM_THREAD_LOCAL const char* WasmHeapProfilerCurrentTag = nullptr;
+#endif
+
+// +--------------------------------------------------------------+
+// |                           Locking                            |
+// +--------------------------------------------------------------+
+// The browser doesn't allow memory.atomic.wait on the main thread so these just spin. They are only ever
+// held for the length of a single TLSF operation (or a memory.grow) so contention should be short-lived
+#if WASM_HEAP_THREAD_SAFE
+static inline void WasmSpinLockAcquire(uint32_t* lockPntr)
+{
+	while (__atomic_exchange_n(lockPntr, 1, __ATOMIC_ACQUIRE) != 0)
+	{
+		while (__atomic_load_n(lockPntr, __ATOMIC_RELAXED) != 0) { }
+	}
+}
+static inline void WasmSpinLockRelease(uint32_t* lockPntr)
+{
+	__atomic_store_n(lockPntr, 0, __ATOMIC_RELEASE);
+}
+#define WasmHeapLock()   WasmSpinLockAcquire(&WasmHeapLockValue)
+#define WasmHeapUnlock() WasmSpinLockRelease(&WasmHeapLockValue)
+#else
+#define WasmHeapLock()   //nothing
+#define WasmHeapUnlock() //nothing
+#endif
 
 // +--------------------------------------------------------------+
 // |                          Heap Base                           |
@@ -42,26 +268,895 @@ void InitWasmMemory(uint32_t numInitialPages)
 	WasmMemoryNumPagesAllocated = numInitialPages;
 	WasmMemoryHeapStartAddress = GetHeapBaseAddress();
 	WasmMemoryHeapCurrentAddress = WasmMemoryHeapStartAddress;
+	WasmMemoryKnownZeroAddress = WasmMemoryHeapStartAddress;
+}
+
+// Atomic max, in thread safe mode other threads might be raising the mark at the same time
+static inline void WasmMemoryMarkDirty(uint32_t endAddress)
+{
+	uint32_t knownZeroAddress = __atomic_load_n(&WasmMemoryKnownZeroAddress, __ATOMIC_RELAXED);
+	while (endAddress > knownZeroAddress)
+	{
+		if (__atomic_compare_exchange_n(&WasmMemoryKnownZeroAddress, &knownZeroAddress, endAddress, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { break; }
+	}
+}
+
+// Grows the memory to at least numPagesNeeded. We grow by a fraction of the current size (if that's more than what
+// was asked for) so a stream of small allocations doesn't turn into a memory.grow (and ArrayBuffer detach) on every page
+void WasmMemoryGrow(uint32_t numPagesNeeded)
+{
+	#if WASM_HEAP_THREAD_SAFE
+	WasmSpinLockAcquire(&WasmMemoryGrowLockValue);
+	if (WasmMemoryNumPagesAllocated >= numPagesNeeded) { WasmSpinLockRelease(&WasmMemoryGrowLockValue); return; } //another thread beat us to it
+	#endif
+	
+	uint32_t numPagesToGrow = numPagesNeeded - WasmMemoryNumPagesAllocated;
+	uint32_t geometricNumPages = (uint32_t)(((uint64_t)WasmMemoryNumPagesAllocated * WasmMemoryGrowthPercent) / 100);
+	if (numPagesToGrow < geometricNumPages) { numPagesToGrow = geometricNumPages; }
+	if (numPagesToGrow < WasmMemoryMinGrowNumPages) { numPagesToGrow = WasmMemoryMinGrowNumPages; }
+	if (WasmMemoryNumPagesAllocated + numPagesToGrow > WasmMemoryMaxNumPages) { numPagesToGrow = WasmMemoryMaxNumPages - WasmMemoryNumPagesAllocated; }
+	
+	size_t prevNumPages = __builtin_wasm_memory_grow(0, numPagesToGrow);
+	if (prevNumPages == (size_t)-1 && numPagesToGrow > numPagesNeeded - WasmMemoryNumPagesAllocated)
+	{
+		// The host might have a lower limit than we think (like a maximum on the WebAssembly.Memory), try asking for only what we need
+		numPagesToGrow = numPagesNeeded - WasmMemoryNumPagesAllocated;
+		prevNumPages = __builtin_wasm_memory_grow(0, numPagesToGrow);
+	}
+	if (prevNumPages == (size_t)-1)
+	{
+		jsStdAbort("The WebAssembly module has run out of memory! memory.grow failed", -1);
+		return;
+	}
+	
+	__atomic_store_n(&WasmMemoryNumPagesAllocated, (uint32_t)prevNumPages + numPagesToGrow, __ATOMIC_RELEASE);
+	WasmMemoryStatAdd(numGrows, 1);
+	jsStdMemoryGrown((uint32_t)prevNumPages, (uint32_t)prevNumPages + numPagesToGrow);
+	
+	#if WASM_HEAP_THREAD_SAFE
+	WasmSpinLockRelease(&WasmMemoryGrowLockValue);
+	#endif
+}
+
+// Allows the application to tune how aggressively we grow memory (see WasmMemoryGrow)
+// growthPercent of 0 means we only ever grow by exactly what is needed, maxNumPages of 0 means WASM_MEMORY_MAX_NUM_PAGES
+// void SetWasmMemoryGrowthPolicy(uint32_t growthPercent, uint32_t minGrowNumPages, uint32_t maxNumPages)
+WASM_EXPORTED_FUNC(void, SetWasmMemoryGrowthPolicy, uint32_t growthPercent, uint32_t minGrowNumPages, uint32_t maxNumPages)
+{
+	WasmMemoryGrowthPercent = growthPercent;
+	WasmMemoryMinGrowNumPages = minGrowNumPages;
+	WasmMemoryMaxNumPages = ((maxNumPages > 0 && maxNumPages < WASM_MEMORY_MAX_NUM_PAGES) ? maxNumPages : WASM_MEMORY_MAX_NUM_PAGES);
+}
+
+// Makes sure the memory actually extends to endAddress (which has already been reserved with the bump pointer)
+static inline void WasmMemoryCommit(uint32_t endAddress)
+{
+	uint32_t numPagesNeeded = (endAddress / WASM_MEMORY_PAGE_SIZE) + (((endAddress % WASM_MEMORY_PAGE_SIZE) != 0) ? 1 : 0);
+	if (__atomic_load_n(&WasmMemoryNumPagesAllocated, __ATOMIC_ACQUIRE) < numPagesNeeded) { WasmMemoryGrow(numPagesNeeded); }
+}
+
+// Moves the bump pointer past numBytes (starting at the next multiple of alignment) and returns the start of that space.
+// prevAddressOut receives where the bump pointer was before, the space in between is the caller's to use or hand to the heap.
+// This is a compare-exchange loop so multiple threads can reserve space at the same time without a lock
+static uint32_t WasmMemoryReserve(uint32_t numBytes, uint32_t alignment, uint32_t* prevAddressOut)
+{
+	uint32_t prevAddress = __atomic_load_n(&WasmMemoryHeapCurrentAddress, __ATOMIC_RELAXED);
+	uint32_t resultAddress, endAddress;
+	do
+	{
+		resultAddress = ((prevAddress + (alignment-1)) & ~(alignment-1));
+		endAddress = resultAddress + numBytes;
+		if (endAddress < prevAddress || (uint64_t)endAddress > (uint64_t)WasmMemoryMaxNumPages * WASM_MEMORY_PAGE_SIZE)
+		{
+			jsStdAbort("The WebAssembly module has run out of memory! WebAssembly only allows for 2GB of memory to be allocated per module", -1);
+			return 0;
+		}
+	} while (!__atomic_compare_exchange_n(&WasmMemoryHeapCurrentAddress, &prevAddress, endAddress, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	
+	WasmMemoryCommit(endAddress);
+	if (prevAddressOut != nullptr) { *prevAddressOut = prevAddress; }
+	return resultAddress;
+}
+
+// Memory returned from this is still all zeroes, only the heap should use this directly since it tracks which parts it writes to
+static void* WasmMemoryAllocateUntouched(uint32_t numBytes)
+{
+	uint32_t prevAddress = 0;
+	uint32_t resultAddress = WasmMemoryReserve(numBytes, WASM_MEMORY_ALIGNMENT, &prevAddress);
+	WasmMemoryStatAdd(alignmentWasteBytes, resultAddress - prevAddress);
+	return (void*)resultAddress;
+}
+
+// Only succeeds if the bump pointer is exactly at address, which lets the heap extend it's top pool without any gap
+static void* WasmMemoryAllocateUntouchedAt(uint32_t address, uint32_t numBytes)
+{
+	uint32_t expectedAddress = address;
+	if (address + numBytes < address || (uint64_t)(address + numBytes) > (uint64_t)WasmMemoryMaxNumPages * WASM_MEMORY_PAGE_SIZE) { return nullptr; }
+	if (!__atomic_compare_exchange_n(&WasmMemoryHeapCurrentAddress, &expectedAddress, address + numBytes, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { return nullptr; }
+	WasmMemoryCommit(address + numBytes);
+	return (void*)address;
 }
 
 void* WasmMemoryAllocate(uint32_t numBytes)
 {
-	uint32_t numBytesNeeded = (WasmMemoryHeapCurrentAddress + numBytes);
-	uint32_t numPagesNeeded = numBytesNeeded / WASM_MEMORY_PAGE_SIZE;
-	if ((numBytesNeeded % WASM_MEMORY_PAGE_SIZE) != 0) { numPagesNeeded++; }
-	if (numPagesNeeded > WASM_MEMORY_MAX_NUM_PAGES)
+	void* result = WasmMemoryAllocateUntouched(numBytes);
+	WasmMemoryMarkDirty((uint32_t)result + numBytes);
+	return result;
+}
+
+static WasmHeapBlock_t* WasmHeapAddMemory(uint32_t address, uint32_t size);
+static inline void WasmHeapInsertFreeBlock(WasmHeapBlock_t* block);
+
+// Allocates whole pages that are aligned to WASM_MEMORY_PAGE_SIZE
+// Any space we skip over to get to the page boundary is handed to the heap rather than being wasted
+void* WasmMemoryAllocatePages(uint32_t numPages)
+{
+	uint32_t prevAddress = 0;
+	uint32_t resultAddress = WasmMemoryReserve(numPages * WASM_MEMORY_PAGE_SIZE, WASM_MEMORY_PAGE_SIZE, &prevAddress);
+	WasmMemoryMarkDirty(resultAddress + numPages * WASM_MEMORY_PAGE_SIZE);
+	
+	uint32_t gapAddress = ((prevAddress + (WASM_MEMORY_ALIGNMENT-1)) & ~(WASM_MEMORY_ALIGNMENT-1));
+	if (gapAddress < resultAddress)
+	{
+		WasmHeapLock();
+		WasmHeapBlock_t* gapBlock = WasmHeapAddMemory(gapAddress, resultAddress - gapAddress);
+		if (gapBlock != nullptr) { WasmHeapInsertFreeBlock(gapBlock); }
+		else { WasmMemoryStatAdd(alignmentWasteBytes, resultAddress - gapAddress); }
+		WasmHeapUnlock();
+	}
+	return (void*)resultAddress;
+}
+
+// +--------------------------------------------------------------+
+// |                         Heap Helpers                         |
+// +--------------------------------------------------------------+
+static inline uint32_t WasmHeapBlockSize(const WasmHeapBlock_t* block)
+{
+	return (block->size & ~WASM_HEAP_FLAGS_MASK);
+}
+static inline WasmHeapBlock_t* WasmHeapNextPhysical(const WasmHeapBlock_t* block)
+{
+	return (WasmHeapBlock_t*)((uint8_t*)block + WasmHeapBlockSize(block));
+}
+static inline void* WasmHeapBlockToPntr(const WasmHeapBlock_t* block)
+{
+	return (void*)((uint8_t*)block + WASM_HEAP_HEADER_SIZE);
+}
+static inline WasmHeapBlock_t* WasmHeapPntrToBlock(const void* pntr)
+{
+	return (WasmHeapBlock_t*)((uint8_t*)pntr - WASM_HEAP_HEADER_SIZE);
+}
+
+// Converts a requested number of bytes into the total block size (header included)
+static inline uint32_t WasmHeapAdjustSize(uint32_t numBytes)
+{
+	uint32_t result = ((numBytes + WASM_HEAP_HEADER_SIZE + (WASM_HEAP_ALIGNMENT-1)) & ~(WASM_HEAP_ALIGNMENT-1));
+	return ((result < WASM_HEAP_MIN_BLOCK_SIZE) ? WASM_HEAP_MIN_BLOCK_SIZE : result);
+}
+
+// Finds the bin that a block of blockSize belongs in (used when inserting free blocks)
+static inline void WasmHeapMappingInsert(uint32_t blockSize, uint32_t* flOut, uint32_t* slOut)
+{
+	if (blockSize < WASM_HEAP_SMALL_BLOCK_SIZE)
+	{
+		*flOut = 0;
+		*slOut = blockSize / (WASM_HEAP_SMALL_BLOCK_SIZE / WASM_HEAP_SL_COUNT);
+	}
+	else
 	{
-		jsStdAbort("The WebAssembly module has run out of memory! WebAssembly only allows for 2GB of memory to be allocated per module", -1);
-		return nullptr;
+		uint32_t highBit = 31 - __builtin_clz(blockSize);
+		*slOut = (blockSize >> (highBit - WASM_HEAP_SL_COUNT_LOG2)) ^ (1 << WASM_HEAP_SL_COUNT_LOG2);
+		*flOut = highBit - (WASM_HEAP_FL_SHIFT - 1);
 	}
-	else if (WasmMemoryNumPagesAllocated < numPagesNeeded)
+}
+
+// Rounds blockSize up to the next bin boundary so that any block found in the resulting bin is big enough
+static inline void WasmHeapMappingSearch(uint32_t blockSize, uint32_t* flOut, uint32_t* slOut)
+{
+	if (blockSize >= WASM_HEAP_SMALL_BLOCK_SIZE)
 	{
-		jsStdGrowMemory(numPagesNeeded - WasmMemoryNumPagesAllocated);
-		WasmMemoryNumPagesAllocated = numPagesNeeded;
+		uint32_t roundUp = (1 << ((31 - __builtin_clz(blockSize)) - WASM_HEAP_SL_COUNT_LOG2)) - 1;
+		blockSize += roundUp;
 	}
+	WasmHeapMappingInsert(blockSize, flOut, slOut);
+}
+
+static inline void WasmHeapInsertFreeBlock(WasmHeapBlock_t* block)
+{
+	WasmMemoryMarkDirty((uint32_t)block + WASM_HEAP_MIN_BLOCK_SIZE); //header and free list links
+	uint32_t flIndex, slIndex;
+	WasmHeapMappingInsert(WasmHeapBlockSize(block), &flIndex, &slIndex);
+	WasmHeapBlock_t* listHead = WasmHeapFreeLists[flIndex][slIndex];
+	block->nextFree = listHead;
+	block->prevFree = nullptr;
+	if (listHead != nullptr) { listHead->prevFree = block; }
+	WasmHeapFreeLists[flIndex][slIndex] = block;
+	WasmHeapFirstLevelBitmap |= (1U << flIndex);
+	WasmHeapSecondLevelBitmaps[flIndex] |= (1U << slIndex);
+}
+
+static inline void WasmHeapRemoveFreeBlock(WasmHeapBlock_t* block)
+{
+	uint32_t flIndex, slIndex;
+	WasmHeapMappingInsert(WasmHeapBlockSize(block), &flIndex, &slIndex);
+	if (block->prevFree != nullptr) { block->prevFree->nextFree = block->nextFree; }
+	else
+	{
+		WasmHeapFreeLists[flIndex][slIndex] = block->nextFree;
+		if (block->nextFree == nullptr)
+		{
+			WasmHeapSecondLevelBitmaps[flIndex] &= ~(1U << slIndex);
+			if (WasmHeapSecondLevelBitmaps[flIndex] == 0) { WasmHeapFirstLevelBitmap &= ~(1U << flIndex); }
+		}
+	}
+	if (block->nextFree != nullptr) { block->nextFree->prevFree = block->prevFree; }
+}
+
+// Finds (and removes from the free lists) a free block that is at least blockSize, returns nullptr if none exist
+static WasmHeapBlock_t* WasmHeapFindFreeBlock(uint32_t blockSize)
+{
+	uint32_t flIndex, slIndex;
+	WasmHeapMappingSearch(blockSize, &flIndex, &slIndex);
+	if (flIndex >= WASM_HEAP_FL_COUNT) { return nullptr; }
 	
-	void* result = (void*)(WasmMemoryHeapCurrentAddress);
-	WasmMemoryHeapCurrentAddress += numBytes;
+	uint32_t slBitmap = WasmHeapSecondLevelBitmaps[flIndex] & (~0U << slIndex);
+	if (slBitmap == 0)
+	{
+		uint32_t flBitmap = (WasmHeapFirstLevelBitmap & (~0U << (flIndex+1)));
+		if (flBitmap == 0) { return nullptr; }
+		flIndex = __builtin_ctz(flBitmap);
+		slBitmap = WasmHeapSecondLevelBitmaps[flIndex];
+	}
+	slIndex = __builtin_ctz(slBitmap);
 	
+	WasmHeapBlock_t* result = WasmHeapFreeLists[flIndex][slIndex];
+	WasmHeapRemoveFreeBlock(result);
 	return result;
 }
+
+// Marks a free block (that has already been removed from the free lists) as used,
+// splitting off any leftover space at the end as a new free block
+static inline void WasmHeapUseBlock(WasmHeapBlock_t* block, uint32_t blockSize)
+{
+	uint32_t availableSize = WasmHeapBlockSize(block);
+	if (availableSize - blockSize >= WASM_HEAP_MIN_BLOCK_SIZE)
+	{
+		WasmHeapBlock_t* remainder = (WasmHeapBlock_t*)((uint8_t*)block + blockSize);
+		remainder->size = (availableSize - blockSize) | WASM_HEAP_FREE_FLAG;
+		WasmHeapNextPhysical(remainder)->prevPhysical = remainder;
+		WasmHeapInsertFreeBlock(remainder);
+		block->size = blockSize | (block->size & WASM_HEAP_PREV_FREE_FLAG);
+	}
+	else
+	{
+		block->size &= ~WASM_HEAP_FREE_FLAG;
+		WasmHeapNextPhysical(block)->size &= ~WASM_HEAP_PREV_FREE_FLAG;
+	}
+}
+
+// Marks a used block as free, coalescing it with it's neighbors, and puts the result in the free lists
+static void WasmHeapFreeBlock(WasmHeapBlock_t* block)
+{
+	block->size |= WASM_HEAP_FREE_FLAG;
+	
+	if ((block->size & WASM_HEAP_PREV_FREE_FLAG) != 0)
+	{
+		WasmHeapBlock_t* prevBlock = block->prevPhysical;
+		WasmHeapRemoveFreeBlock(prevBlock);
+		prevBlock->size += WasmHeapBlockSize(block);
+		block = prevBlock;
+	}
+	
+	WasmHeapBlock_t* nextBlock = WasmHeapNextPhysical(block);
+	if ((nextBlock->size & WASM_HEAP_FREE_FLAG) != 0)
+	{
+		WasmHeapRemoveFreeBlock(nextBlock);
+		block->size += WasmHeapBlockSize(nextBlock);
+		nextBlock = WasmHeapNextPhysical(block);
+	}
+	
+	nextBlock->prevPhysical = block;
+	nextBlock->size |= WASM_HEAP_PREV_FREE_FLAG;
+	WasmHeapInsertFreeBlock(block);
+}
+
+// Hands the region [address, address+size) to the heap. If the region directly follows the last pool
+// then that pool is simply extended (and merged with it's last block if that block is free)
+// Returns the resulting free block (NOT in the free lists) or nullptr if the region was too small to be useful
+static WasmHeapBlock_t* WasmHeapAddMemory(uint32_t address, uint32_t size)
+{
+	WasmHeapBlock_t* result = nullptr;
+	if (WasmHeapTopPoolEnd != 0 && address == WasmHeapTopPoolEnd)
+	{
+		// The old sentinel becomes the header of the new block and a new sentinel gets placed at the end
+		uint32_t growSize = (size & ~(WASM_HEAP_ALIGNMENT-1));
+		if (growSize == 0) { return nullptr; }
+		WasmHeapBlock_t* oldSentinel = (WasmHeapBlock_t*)(WasmHeapTopPoolEnd - WASM_HEAP_HEADER_SIZE);
+		WasmHeapTopPoolEnd += growSize;
+		
+		result = oldSentinel;
+		result->size = growSize | WASM_HEAP_FREE_FLAG | (oldSentinel->size & WASM_HEAP_PREV_FREE_FLAG);
+		if ((result->size & WASM_HEAP_PREV_FREE_FLAG) != 0)
+		{
+			WasmHeapBlock_t* prevBlock = result->prevPhysical;
+			WasmHeapRemoveFreeBlock(prevBlock);
+			prevBlock->size += growSize;
+			result = prevBlock;
+		}
+	}
+	else
+	{
+		// A brand new pool, the first block takes up all the space except for the sentinel at the end
+		uint32_t alignPadding = ((WASM_HEAP_ALIGNMENT + WASM_HEAP_BLOCK_ALIGN_OFFSET - (address % WASM_HEAP_ALIGNMENT)) % WASM_HEAP_ALIGNMENT);
+		if (size < alignPadding + WASM_HEAP_MIN_BLOCK_SIZE + WASM_HEAP_HEADER_SIZE) { return nullptr; }
+		uint32_t blockSize = ((size - alignPadding - WASM_HEAP_HEADER_SIZE) & ~(WASM_HEAP_ALIGNMENT-1));
+		result = (WasmHeapBlock_t*)(address + alignPadding);
+		result->size = blockSize | WASM_HEAP_FREE_FLAG;
+		WasmMemoryStatAdd(alignmentWasteBytes, size - blockSize - WASM_HEAP_HEADER_SIZE);
+		WasmHeapTopPoolEnd = (uint32_t)result + blockSize + WASM_HEAP_HEADER_SIZE;
+	}
+	
+	WasmHeapBlock_t* sentinel = WasmHeapNextPhysical(result);
+	WasmMemoryMarkDirty(WasmHeapTopPoolEnd);
+	sentinel->prevPhysical = result;
+	sentinel->size = 0 | WASM_HEAP_PREV_FREE_FLAG;
+	return result;
+}
+
+// Gets more memory from the page logic, returns a free block (NOT in the free lists) that is at least blockSize large
+static WasmHeapBlock_t* WasmHeapGrow(uint32_t blockSize)
+{
+	if (WasmHeapTopPoolEnd != 0)
+	{
+		// If the last block in the top pool is free then we only need enough to make up the difference
+		uint32_t growSize = blockSize;
+		WasmHeapBlock_t* oldSentinel = (WasmHeapBlock_t*)(WasmHeapTopPoolEnd - WASM_HEAP_HEADER_SIZE);
+		if ((oldSentinel->size & WASM_HEAP_PREV_FREE_FLAG) != 0)
+		{
+			uint32_t prevSize = WasmHeapBlockSize(oldSentinel->prevPhysical);
+			growSize = ((blockSize > prevSize) ? (blockSize - prevSize) : 0);
+		}
+		if (growSize < WASM_HEAP_MIN_GROW_SIZE) { growSize = WASM_HEAP_MIN_GROW_SIZE; }
+		
+		// This fails if anything else has been bump allocated since the top pool was made, then we need a new pool
+		void* newMemory = WasmMemoryAllocateUntouchedAt(WasmHeapTopPoolEnd, growSize);
+		if (newMemory != nullptr) { return WasmHeapAddMemory((uint32_t)newMemory, growSize); }
+	}
+	
+	// WasmMemoryAllocateUntouched hands back an aligned address so the new pool's first block always needs the same padding
+	uint32_t growSize = WASM_HEAP_BLOCK_ALIGN_OFFSET + blockSize + WASM_HEAP_HEADER_SIZE;
+	if (growSize < WASM_HEAP_MIN_GROW_SIZE) { growSize = WASM_HEAP_MIN_GROW_SIZE; }
+	void* newMemory = WasmMemoryAllocateUntouched(growSize);
+	return WasmHeapAddMemory((uint32_t)newMemory, growSize);
+}
+
+// +--------------------------------------------------------------+
+// |                         TLSF Heap                            |
+// +--------------------------------------------------------------+
+void* WasmTlsfAllocate(uint32_t numBytes)
+{
+	if (numBytes > WASM_HEAP_MAX_ALLOC_SIZE) { return nullptr; }
+	uint32_t blockSize = WasmHeapAdjustSize(numBytes);
+	WasmHeapBlock_t* block = WasmHeapFindFreeBlock(blockSize);
+	if (block == nullptr) { block = WasmHeapGrow(blockSize); }
+	WasmHeapUseBlock(block, blockSize);
+	WasmMemoryMarkDirty((uint32_t)WasmHeapNextPhysical(block));
+	WasmMemoryStatAdd(liveBytes, WasmHeapBlockSize(block) - WASM_HEAP_HEADER_SIZE);
+	WasmMemoryStatAdd(allocCounts[WASM_SLAB_NUM_CLASSES], 1);
+	WasmMemoryStatUpdatePeak();
+	return WasmHeapBlockToPntr(block);
+}
+
+// For alignments larger than WASM_HEAP_ALIGNMENT. We look for a block big enough that we can always find an aligned
+// address in it that leaves either no space or a valid free block in front of it, and give that leading space back to the heap
+void* WasmTlsfAllocateAligned(uint32_t numBytes, uint32_t alignment)
+{
+	if (numBytes > WASM_HEAP_MAX_ALLOC_SIZE - alignment) { return nullptr; }
+	uint32_t blockSize = WasmHeapAdjustSize(numBytes);
+	uint32_t searchSize = blockSize + alignment + WASM_HEAP_MIN_BLOCK_SIZE;
+	WasmHeapBlock_t* block = WasmHeapFindFreeBlock(searchSize);
+	if (block == nullptr) { block = WasmHeapGrow(searchSize); }
+	
+	uint32_t pntrAddress = (uint32_t)WasmHeapBlockToPntr(block);
+	uint32_t alignedAddress = ((pntrAddress + (alignment-1)) & ~(alignment-1));
+	if (alignedAddress != pntrAddress && alignedAddress - pntrAddress < WASM_HEAP_MIN_BLOCK_SIZE)
+	{
+		alignedAddress = ((pntrAddress + WASM_HEAP_MIN_BLOCK_SIZE + (alignment-1)) & ~(alignment-1));
+	}
+	
+	uint32_t gapSize = alignedAddress - pntrAddress;
+	if (gapSize > 0)
+	{
+		// The block we found is free so the block before it can't be, which means the gap never needs to coalesce backwards
+		WasmHeapBlock_t* alignedBlock = WasmHeapPntrToBlock((void*)alignedAddress);
+		alignedBlock->size = (WasmHeapBlockSize(block) - gapSize) | WASM_HEAP_FREE_FLAG | WASM_HEAP_PREV_FREE_FLAG;
+		alignedBlock->prevPhysical = block;
+		WasmHeapNextPhysical(alignedBlock)->prevPhysical = alignedBlock;
+		block->size = gapSize | WASM_HEAP_FREE_FLAG | (block->size & WASM_HEAP_PREV_FREE_FLAG);
+		WasmHeapInsertFreeBlock(block);
+		block = alignedBlock;
+	}
+	
+	WasmHeapUseBlock(block, blockSize);
+	WasmMemoryMarkDirty((uint32_t)WasmHeapNextPhysical(block));
+	WasmMemoryStatAdd(liveBytes, WasmHeapBlockSize(block) - WASM_HEAP_HEADER_SIZE);
+	WasmMemoryStatAdd(allocCounts[WASM_SLAB_NUM_CLASSES], 1);
+	WasmMemoryStatUpdatePeak();
+	return WasmHeapBlockToPntr(block);
+}
+
+void WasmTlsfFree(void* allocPntr)
+{
+	WasmHeapBlock_t* block = WasmHeapPntrToBlock(allocPntr);
+	assert((block->size & WASM_HEAP_FREE_FLAG) == 0 && "Double free detected in WasmTlsfFree!");
+	WasmMemoryStatSub(liveBytes, WasmHeapBlockSize(block) - WASM_HEAP_HEADER_SIZE);
+	WasmMemoryStatAdd(freeCounts[WASM_SLAB_NUM_CLASSES], 1);
+	WasmHeapFreeBlock(block);
+}
+
+void* WasmTlsfReallocate(void* prevAllocPntr, uint32_t newSize)
+{
+	if (newSize > WASM_HEAP_MAX_ALLOC_SIZE) { return nullptr; }
+	
+	WasmHeapBlock_t* block = WasmHeapPntrToBlock(prevAllocPntr);
+	uint32_t blockSize = WasmHeapAdjustSize(newSize);
+	uint32_t currentSize = WasmHeapBlockSize(block);
+	
+	if (blockSize > currentSize)
+	{
+		WasmHeapBlock_t* nextBlock = WasmHeapNextPhysical(block);
+		uint32_t nextFreeSize = (((nextBlock->size & WASM_HEAP_FREE_FLAG) != 0) ? WasmHeapBlockSize(nextBlock) : 0);
+		
+		// If we are the last block in the top pool (ignoring a free block after us) and nothing has been bump allocated
+		// after that pool then we can extend the pool by exactly what we are missing rather than moving anything
+		if (currentSize + nextFreeSize < blockSize)
+		{
+			WasmHeapBlock_t* lastBlock = ((nextFreeSize > 0) ? WasmHeapNextPhysical(nextBlock) : nextBlock);
+			uint32_t growSize = blockSize - (currentSize + nextFreeSize);
+			if ((uint32_t)lastBlock + WASM_HEAP_HEADER_SIZE == WasmHeapTopPoolEnd && WasmMemoryAllocateUntouchedAt(WasmHeapTopPoolEnd, growSize) != nullptr)
+			{
+				WasmHeapBlock_t* newBlock = WasmHeapAddMemory(WasmHeapTopPoolEnd, growSize);
+				if (newBlock != nullptr) { WasmHeapInsertFreeBlock(newBlock); }
+				nextFreeSize = (((nextBlock->size & WASM_HEAP_FREE_FLAG) != 0) ? WasmHeapBlockSize(nextBlock) : 0);
+			}
+		}
+		
+		// Absorb the free block after us if that gives us enough space, the shrink logic below hands back whatever we don't need
+		if (currentSize + nextFreeSize >= blockSize)
+		{
+			WasmHeapRemoveFreeBlock(nextBlock);
+			WasmHeapNextPhysical(nextBlock)->size &= ~WASM_HEAP_PREV_FREE_FLAG;
+			block->size += nextFreeSize;
+			WasmMemoryStatAdd(liveBytes, nextFreeSize);
+			currentSize += nextFreeSize;
+		}
+	}
+	
+	// Shrinking (or staying the same size) always happens in place, any leftover space gets handed back
+	if (blockSize <= currentSize)
+	{
+		if (currentSize - blockSize >= WASM_HEAP_MIN_BLOCK_SIZE)
+		{
+			WasmHeapBlock_t* remainder = (WasmHeapBlock_t*)((uint8_t*)block + blockSize);
+			remainder->size = (currentSize - blockSize);
+			block->size = blockSize | (block->size & WASM_HEAP_PREV_FREE_FLAG);
+			WasmHeapFreeBlock(remainder);
+			WasmMemoryStatSub(liveBytes, currentSize - blockSize);
+		}
+		WasmMemoryMarkDirty((uint32_t)WasmHeapNextPhysical(block));
+		WasmMemoryStatUpdatePeak();
+		return prevAllocPntr;
+	}
+	
+	void* result = WasmTlsfAllocate(newSize);
+	memcpy(result, prevAllocPntr, currentSize - WASM_HEAP_HEADER_SIZE);
+	WasmTlsfFree(prevAllocPntr);
+	return result;
+}
+
+// +--------------------------------------------------------------+
+// |                   Slab (Small Object) Heap                   |
+// +--------------------------------------------------------------+
+// Small allocations are served from 64kB pages that each hold blocks of a single size class.
+// The page header lives at the start of the page so a block's size class can be found by masking it's address,
+// which means the blocks themselves don't need any header at all.
+static inline bool WasmSlabIsSlabPntr(const void* pntr)
+{
+	uint32_t pageIndex = ((uint32_t)pntr / WASM_MEMORY_PAGE_SIZE);
+	return ((__atomic_load_n(&WasmSlabPageBitmap[pageIndex / 32], __ATOMIC_RELAXED) & (1U << (pageIndex % 32))) != 0);
+}
+static inline WasmSlabPage_t* WasmSlabGetPage(const void* pntr)
+{
+	return (WasmSlabPage_t*)((uint32_t)pntr & ~(WASM_MEMORY_PAGE_SIZE-1));
+}
+
+static inline void WasmSlabPushPartialPage(WasmSlabPage_t* page)
+{
+	WasmSlabPage_t** listHead = &WasmSlabThreadHeap.partialPages[page->classIndex];
+	page->prev = nullptr;
+	page->next = *listHead;
+	if (*listHead != nullptr) { (*listHead)->prev = page; }
+	*listHead = page;
+}
+static inline void WasmSlabRemovePartialPage(WasmSlabPage_t* page)
+{
+	if (page->prev != nullptr) { page->prev->next = page->next; }
+	else { WasmSlabThreadHeap.partialPages[page->classIndex] = page->next; }
+	if (page->next != nullptr) { page->next->prev = page->prev; }
+	page->next = nullptr;
+	page->prev = nullptr;
+}
+
+static WasmSlabPage_t* WasmSlabNewPage(uint32_t classIndex)
+{
+	WasmHeapLock();
+	WasmSlabPage_t* page = WasmSlabEmptyPages;
+	if (page != nullptr) { WasmSlabEmptyPages = page->next; }
+	WasmHeapUnlock();
+	if (page == nullptr)
+	{
+		page = (WasmSlabPage_t*)WasmMemoryAllocatePages(1);
+		uint32_t pageIndex = ((uint32_t)page / WASM_MEMORY_PAGE_SIZE);
+		__atomic_fetch_or(&WasmSlabPageBitmap[pageIndex / 32], (1U << (pageIndex % 32)), __ATOMIC_RELAXED);
+	}
+	
+	#if WASM_HEAP_THREAD_SAFE
+	page->owner = &WasmSlabThreadHeap;
+	page->remoteFreeList = nullptr;
+	page->nextRemotePage = nullptr;
+	#endif
+	page->classIndex = classIndex;
+	page->blockSize = WasmSlabClassSizes[classIndex];
+	page->numBlocks = (WASM_MEMORY_PAGE_SIZE - WASM_SLAB_HEADER_SIZE) / page->blockSize;
+	page->numUsed = 0;
+	page->freeList = nullptr;
+	page->bumpOffset = WASM_SLAB_HEADER_SIZE;
+	WasmSlabPushPartialPage(page);
+	return page;
+}
+
+#if WASM_HEAP_THREAD_SAFE
+static void WasmSlabCollectRemoteFrees();
+#endif
+
+static inline void* WasmSlabAllocate(uint32_t numBytes)
+{
+	uint32_t classIndex = WasmSlabSizeToClass[(numBytes + 7) / 8];
+	WasmSlabPage_t* page = WasmSlabThreadHeap.partialPages[classIndex];
+	#if WASM_HEAP_THREAD_SAFE
+	if (page == nullptr && __atomic_load_n(&WasmSlabThreadHeap.remoteFreePages, __ATOMIC_RELAXED) != nullptr)
+	{
+		// Other threads may have freed blocks in our pages, use those before taking a new page
+		WasmSlabCollectRemoteFrees();
+		page = WasmSlabThreadHeap.partialPages[classIndex];
+	}
+	#endif
+	if (page == nullptr) { page = WasmSlabNewPage(classIndex); }
+	
+	void* result = page->freeList;
+	if (result != nullptr) { page->freeList = *(void**)result; }
+	else
+	{
+		// Blocks that have never been handed out are carved off lazily so new pages don't need to be walked
+		result = (uint8_t*)page + page->bumpOffset;
+		page->bumpOffset += page->blockSize;
+	}
+	
+	page->numUsed++;
+	if (page->numUsed == page->numBlocks) { WasmSlabRemovePartialPage(page); }
+	WasmMemoryStatAdd(liveBytes, page->blockSize);
+	WasmMemoryStatAdd(allocCounts[classIndex], 1);
+	WasmMemoryStatUpdatePeak();
+	return result;
+}
+
+// Only the thread that owns the page is allowed to call this
+static inline void WasmSlabFreeLocal(WasmSlabPage_t* page, void* allocPntr)
+{
+	*(void**)allocPntr = page->freeList;
+	page->freeList = allocPntr;
+	WasmMemoryStatSub(liveBytes, page->blockSize);
+	WasmMemoryStatAdd(freeCounts[page->classIndex], 1);
+	
+	if (page->numUsed == page->numBlocks) { WasmSlabPushPartialPage(page); }
+	page->numUsed--;
+	
+	// Completely empty pages go back into a shared pool so other size classes can use them,
+	// but we hold onto the last page of each class so we don't thrash when a single block is allocated and freed repeatedly
+	if (page->numUsed == 0 && (page->next != nullptr || page->prev != nullptr))
+	{
+		WasmSlabRemovePartialPage(page);
+		WasmHeapLock();
+		page->next = WasmSlabEmptyPages;
+		WasmSlabEmptyPages = page;
+		WasmHeapUnlock();
+	}
+}
+
+#if WASM_HEAP_THREAD_SAFE
+// Blocks freed by a thread that doesn't own the page get pushed onto the page's remoteFreeList with a compare-exchange.
+// The first push also puts the page on the owner's remoteFreePages list so the owner can find it later.
+// Both lists are only ever emptied all at once by the owner (with an exchange) so there's no ABA problem here
+static void WasmSlabRemoteFree(WasmSlabPage_t* page, void* allocPntr)
+{
+	void* prevHead = __atomic_load_n(&page->remoteFreeList, __ATOMIC_RELAXED);
+	do { *(void**)allocPntr = prevHead; }
+	while (!__atomic_compare_exchange_n(&page->remoteFreeList, &prevHead, allocPntr, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+	
+	if (prevHead == nullptr)
+	{
+		WasmSlabThreadHeap_t* owner = page->owner;
+		WasmSlabPage_t* prevPage = __atomic_load_n(&owner->remoteFreePages, __ATOMIC_RELAXED);
+		do { page->nextRemotePage = prevPage; }
+		while (!__atomic_compare_exchange_n(&owner->remoteFreePages, &prevPage, page, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+}
+
+static void WasmSlabCollectRemoteFrees()
+{
+	WasmSlabPage_t* page = __atomic_exchange_n(&WasmSlabThreadHeap.remoteFreePages, nullptr, __ATOMIC_ACQUIRE);
+	while (page != nullptr)
+	{
+		// nextRemotePage has to be read before we empty the remoteFreeList, after that another thread can push the page again
+		WasmSlabPage_t* nextPage = page->nextRemotePage;
+		void* block = __atomic_exchange_n(&page->remoteFreeList, nullptr, __ATOMIC_ACQ_REL);
+		while (block != nullptr)
+		{
+			void* nextBlock = *(void**)block;
+			WasmSlabFreeLocal(page, block);
+			block = nextBlock;
+		}
+		page = nextPage;
+	}
+}
+#endif
+
+static inline void WasmSlabFree(void* allocPntr)
+{
+	WasmSlabPage_t* page = WasmSlabGetPage(allocPntr);
+	#if WASM_HEAP_THREAD_SAFE
+	if (page->owner != &WasmSlabThreadHeap) { WasmSlabRemoteFree(page, allocPntr); return; }
+	#endif
+	WasmSlabFreeLocal(page, allocPntr);
+}
+
+// +--------------------------------------------------------------+
+// |                        Heap Profiler                         |
+// +--------------------------------------------------------------+
+#if WASM_HEAP_PROFILER_ENABLED
+// Counts down the bytes until the next sample so the common case is a single compare and subtract
+static inline void WasmHeapProfilerRecord(uint32_t numBytes)
+{
+	if (numBytes < WasmHeapProfilerBytesUntilSample) { WasmHeapProfilerBytesUntilSample -= numBytes; return; }
+	if (WasmHeapProfilerInfo.sampleInterval == 0) { WasmHeapProfilerBytesUntilSample = UINT32_MAX; return; }
+	uint32_t bytesPastSample = numBytes - WasmHeapProfilerBytesUntilSample;
+	WasmHeapProfilerBytesUntilSample = WasmHeapProfilerInfo.sampleInterval - (bytesPastSample % WasmHeapProfilerInfo.sampleInterval);
+	
+	uint32_t sampleIndex = __atomic_fetch_add(&WasmHeapProfilerInfo.numSamplesRecorded, 1, __ATOMIC_RELAXED);
+	WasmHeapProfilerSample_t* sample = &WasmHeapProfilerSamples[sampleIndex % WASM_HEAP_PROFILER_NUM_SAMPLES];
+	sample->tag = WasmHeapProfilerCurrentTag;
+	sample->allocSize = numBytes;
+	sample->weight = 1 + (bytesPastSample / WasmHeapProfilerInfo.sampleInterval);
+}
+
+// WasmHeapProfilerInfo_t* GetStdHeapProfilerInfo()
+WASM_EXPORTED_FUNC(WasmHeapProfilerInfo_t*, GetStdHeapProfilerInfo)
+{
+	return &WasmHeapProfilerInfo;
+}
+#else
+#define WasmHeapProfilerRecord(numBytes) //nothing
+#endif
+
+// tagName should be a string literal (or otherwise stay alive until the profile is read), it's stored as a pointer
+const char* StdHeapProfilerSetTag(const char* tagName)
+{
+	#if WASM_HEAP_PROFILER_ENABLED
+	const char* prevTag = WasmHeapProfilerCurrentTag;
+	WasmHeapProfilerCurrentTag = tagName;
+	return prevTag;
+	#else
+	return nullptr;
+	#endif
+}
+
+// numBytes of 0 stops sampling, changing the interval doesn't affect samples that have already been recorded
+// void StdHeapProfilerSetInterval(uint32_t numBytes)
+WASM_EXPORTED_FUNC(void, StdHeapProfilerSetInterval, uint32_t numBytes)
+{
+	#if WASM_HEAP_PROFILER_ENABLED
+	WasmHeapProfilerInfo.sampleInterval = numBytes;
+	WasmHeapProfilerBytesUntilSample = ((numBytes > 0) ? numBytes : UINT32_MAX);
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                        Heap Functions                        |
+// +--------------------------------------------------------------+
+void* WasmHeapAllocate(uint32_t numBytes)
+{
+	WasmHeapProfilerRecord(numBytes);
+	if (numBytes <= WASM_SLAB_MAX_SIZE) { return WasmSlabAllocate(numBytes); }
+	WasmHeapLock();
+	void* result = WasmTlsfAllocate(numBytes);
+	WasmHeapUnlock();
+	return result;
+}
+
+// Only clears the part of the allocation that isn't already known to be zero (see WasmMemoryKnownZeroAddress)
+// so large allocations that come from fresh memory.grow pages don't need to be touched at all
+void* WasmHeapAllocateZeroed(uint32_t numBytes)
+{
+	if (numBytes <= WASM_SLAB_MAX_SIZE)
+	{
+		// Slab pages get reused between size classes (and threads) so it's not worth tracking which blocks are still zero
+		void* result = WasmHeapAllocate(numBytes);
+		if (result != nullptr) { memset(result, 0x00, numBytes); }
+		return result;
+	}
+	
+	// The mark has to be read while holding the lock, otherwise another thread could free dirty memory into the heap before we take it
+	WasmHeapProfilerRecord(numBytes);
+	WasmHeapLock();
+	uint32_t knownZeroAddress = __atomic_load_n(&WasmMemoryKnownZeroAddress, __ATOMIC_RELAXED);
+	void* result = WasmTlsfAllocate(numBytes);
+	WasmHeapUnlock();
+	if (result == nullptr) { return nullptr; }
+	uint32_t resultAddress = (uint32_t)result;
+	if (resultAddress < knownZeroAddress)
+	{
+		uint32_t numDirtyBytes = knownZeroAddress - resultAddress;
+		memset(result, 0x00, ((numDirtyBytes < numBytes) ? numDirtyBytes : numBytes));
+	}
+	return result;
+}
+
+// alignment must be a power of two no larger than WASM_MEMORY_PAGE_SIZE. Anything up to WASM_HEAP_ALIGNMENT
+// (16) costs nothing extra: slab blocks are 16-byte aligned (8 for the 8 byte class) and so are TLSF blocks
+void* WasmHeapAllocateAligned(uint32_t numBytes, uint32_t alignment)
+{
+	if (alignment == 0 || (alignment & (alignment-1)) != 0 || alignment > WASM_MEMORY_PAGE_SIZE) { return nullptr; }
+	WasmHeapProfilerRecord(numBytes);
+	if (alignment <= WASM_HEAP_ALIGNMENT)
+	{
+		// Every slab class except 8 is a multiple of 16, so rounding up to the alignment always lands in a class that satisfies it
+		uint32_t roundedNumBytes = ((numBytes > 0) ? ((numBytes + (alignment-1)) & ~(alignment-1)) : alignment);
+		if (roundedNumBytes <= WASM_SLAB_MAX_SIZE) { return WasmSlabAllocate(roundedNumBytes); }
+	}
+	WasmHeapLock();
+	void* result = ((alignment <= WASM_HEAP_ALIGNMENT) ? WasmTlsfAllocate(numBytes) : WasmTlsfAllocateAligned(numBytes, alignment));
+	WasmHeapUnlock();
+	return result;
+}
+
+void WasmHeapFree(void* allocPntr)
+{
+	if (allocPntr == nullptr) { return; }
+	if (WasmSlabIsSlabPntr(allocPntr)) { WasmSlabFree(allocPntr); }
+	else
+	{
+		WasmHeapLock();
+		WasmTlsfFree(allocPntr);
+		WasmHeapUnlock();
+	}
+}
+
+// numBytes and alignment must match what was passed to WasmHeapAllocate (alignment 0) or WasmHeapAllocateAligned.
+// Those decide which allocator the pointer came from, so unlike WasmHeapFree we don't need to check the slab page bitmap
+void WasmHeapFreeSized(void* allocPntr, uint32_t numBytes, uint32_t alignment)
+{
+	if (allocPntr == nullptr) { return; }
+	uint32_t roundedNumBytes = numBytes;
+	if (alignment > 1) { roundedNumBytes = ((numBytes > 0) ? ((numBytes + (alignment-1)) & ~(alignment-1)) : alignment); }
+	bool isSlab = (alignment <= WASM_HEAP_ALIGNMENT && roundedNumBytes <= WASM_SLAB_MAX_SIZE);
+	assert(isSlab == WasmSlabIsSlabPntr(allocPntr) && "WasmHeapFreeSized was given the wrong size");
+	if (isSlab) { WasmSlabFree(allocPntr); }
+	else
+	{
+		WasmHeapLock();
+		WasmTlsfFree(allocPntr);
+		WasmHeapUnlock();
+	}
+}
+
+// Returns the number of bytes the user can actually use in this allocation (>= the size they asked for)
+uint32_t WasmHeapGetAllocationSize(const void* allocPntr)
+{
+	if (allocPntr == nullptr) { return 0; }
+	if (WasmSlabIsSlabPntr(allocPntr)) { return WasmSlabGetPage(allocPntr)->blockSize; }
+	// The flag bits in the header can be changed by whoever is using the neighboring blocks
+	WasmHeapLock();
+	uint32_t result = WasmHeapBlockSize(WasmHeapPntrToBlock(allocPntr)) - WASM_HEAP_HEADER_SIZE;
+	WasmHeapUnlock();
+	return result;
+}
+
+void* WasmHeapReallocate(void* prevAllocPntr, uint32_t newSize)
+{
+	if (prevAllocPntr == nullptr) { return WasmHeapAllocate(newSize); }
+	if (newSize == 0) { WasmHeapFree(prevAllocPntr); return nullptr; }
+	#if WASM_HEAP_PROFILER_ENABLED
+	uint32_t prevUsableSize = WasmHeapGetAllocationSize(prevAllocPntr);
+	if (newSize > prevUsableSize) { WasmHeapProfilerRecord(newSize - prevUsableSize); }
+	#endif
+	
+	bool isSlab = WasmSlabIsSlabPntr(prevAllocPntr);
+	if (!isSlab && newSize > WASM_SLAB_MAX_SIZE)
+	{
+		WasmHeapLock();
+		void* result = WasmTlsfReallocate(prevAllocPntr, newSize);
+		WasmHeapUnlock();
+		return result;
+	}
+	
+	uint32_t prevSize = WasmHeapGetAllocationSize(prevAllocPntr);
+	if (isSlab && newSize <= prevSize && WasmSlabSizeToClass[(newSize + 7) / 8] == WasmSlabGetPage(prevAllocPntr)->classIndex) { return prevAllocPntr; }
+	
+	// Moving between size classes (or between the slab and TLSF heaps) always needs a copy
+	void* result = nullptr;
+	if (newSize <= WASM_SLAB_MAX_SIZE) { result = WasmSlabAllocate(newSize); }
+	else
+	{
+		WasmHeapLock();
+		result = WasmTlsfAllocate(newSize);
+		WasmHeapUnlock();
+	}
+	if (result == nullptr) { return nullptr; }
+	memcpy(result, prevAllocPntr, ((prevSize < newSize) ? prevSize : newSize));
+	WasmHeapFree(prevAllocPntr);
+	return result;
+}
+
+// +--------------------------------------------------------------+
+// |                          Statistics                          |
+// +--------------------------------------------------------------+
+// Everything that isn't a simple counter is calculated here by walking the TLSF free lists and the slab pages
+// so the allocation functions don't have to pay for it. The result is only valid until the next call.
+// In thread safe mode the slab numbers are only approximate since other threads can be using their pages while we walk them
+// WasmMemoryStats_t* GetWasmMemoryStats()
+WASM_EXPORTED_FUNC(WasmMemoryStats_t*, GetWasmMemoryStats)
+{
+	WasmHeapLock();
+	WasmMemoryStats_t* stats = &WasmMemoryStats;
+	stats->numPagesAllocated = WasmMemoryNumPagesAllocated;
+	stats->numSizeClasses = WASM_HEAP_NUM_STAT_CLASSES;
+	
+	uint32_t tlsfFreeBytes = 0;
+	uint32_t largestFreeBlock = 0;
+	for (uint32_t flIndex = 0; flIndex < WASM_HEAP_FL_COUNT; flIndex++)
+	{
+		if ((WasmHeapFirstLevelBitmap & (1U << flIndex)) == 0) { continue; }
+		for (uint32_t slIndex = 0; slIndex < WASM_HEAP_SL_COUNT; slIndex++)
+		{
+			for (WasmHeapBlock_t* block = WasmHeapFreeLists[flIndex][slIndex]; block != nullptr; block = block->nextFree)
+			{
+				uint32_t usableSize = WasmHeapBlockSize(block) - WASM_HEAP_HEADER_SIZE;
+				tlsfFreeBytes += usableSize;
+				if (usableSize > largestFreeBlock) { largestFreeBlock = usableSize; }
+			}
+		}
+	}
+	
+	uint32_t slabFreeBytes = 0;
+	uint32_t slabOverheadBytes = 0;
+	for (uint32_t wordIndex = 0; wordIndex < WASM_MEMORY_MAX_NUM_PAGES / 32; wordIndex++)
+	{
+		uint32_t bitmapWord = WasmSlabPageBitmap[wordIndex];
+		while (bitmapWord != 0)
+		{
+			uint32_t pageIndex = (wordIndex * 32) + __builtin_ctz(bitmapWord);
+			bitmapWord &= (bitmapWord - 1);
+			const WasmSlabPage_t* page = (const WasmSlabPage_t*)(pageIndex * WASM_MEMORY_PAGE_SIZE);
+			slabFreeBytes += (page->numBlocks - page->numUsed) * page->blockSize;
+			slabOverheadBytes += WASM_MEMORY_PAGE_SIZE - (page->numBlocks * page->blockSize);
+		}
+	}
+	
+	uint32_t numLiveTlsfBlocks = stats->allocCounts[WASM_SLAB_NUM_CLASSES] - stats->freeCounts[WASM_SLAB_NUM_CLASSES];
+	stats->freeBytes = tlsfFreeBytes + slabFreeBytes;
+	stats->largestFreeBlock = largestFreeBlock;
+	stats->fragmentedBytes = tlsfFreeBytes - largestFreeBlock;
+	stats->overheadBytes = (numLiveTlsfBlocks * WASM_HEAP_HEADER_SIZE) + slabOverheadBytes;
+	WasmHeapUnlock();
+	return stats;
+}
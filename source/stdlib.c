@@ -15,30 +15,30 @@ int abs(int value)
 
 void* malloc(size_t numBytes)
 {
-	return WasmMemoryAllocate(numBytes);
+	return WasmHeapAllocate(numBytes);
 }
 
 void* calloc(size_t numElements, size_t elemSize)
 {
-	assert(0 && "callocing memory is not allowed in WebAssembly!");
-	return nullptr;
+	size_t numBytes = numElements * elemSize;
+	if (elemSize != 0 && numBytes / elemSize != numElements) { return nullptr; } //overflow
+	return WasmHeapAllocateZeroed(numBytes);
 }
 
 void* realloc(void* prevAllocPntr, size_t newSize)
 {
-	assert(0 && "reallocing memory is not allowed in WebAssembly!");
-	return nullptr;
+	return WasmHeapReallocate(prevAllocPntr, newSize);
 }
 
 void free(void* allocPntr)
 {
-	assert(0 && "freeing memory is not allowed in WebAssembly!");
+	WasmHeapFree(allocPntr);
 }
 
-void* aligned_alloc(size_t numBytes, size_t alignmentSize)
+// alignmentSize must be a power of two no larger than WASM_MEMORY_PAGE_SIZE (64kB), otherwise this returns nullptr
+void* aligned_alloc(size_t alignmentSize, size_t numBytes)
 {
-	assert(0 && "aligned_allocing memory is not allowed in WebAssembly!");
-	return nullptr;
+	return WasmHeapAllocateAligned((uint32_t)numBytes, (uint32_t)alignmentSize);
 }
 
 static uint64_t stdRandState;
@@ -168,7 +168,9 @@ double atof(const char* str)
 	#endif
 }
 
-void* alloca(size_t numBytes)
+// NOTE: Only here so alloca can still be linked against. The memory is released as soon as this function returns,
+// so nothing in C/C++ should be calling this, the alloca macro in stdlib.h expands to __builtin_alloca in the caller instead
+void* (alloca)(size_t numBytes)
 {
 	return __builtin_alloca(numBytes);
 }
@@ -177,7 +179,8 @@ void* alloca(size_t numBytes)
 
 void qsort(void* basePntr, size_t numItems, size_t itemSize, StdCompareFunc_f* compareFunc)
 {
-	__qsort_r(basePntr, numItems, itemSize, WrapperCompareFunc, compareFunc);
+	QsortContext_t context = { itemSize, QsortSwapKind_Bytes, compareFunc, nullptr, nullptr };
+	QsortRun(&context, basePntr, numItems);
 }
 
 _Noreturn void exit(int exitCode)
@@ -4,242 +4,456 @@ Author: Taylor Robbins
 Date:   10\15\2023
 Description: 
 	** Helper functions for qsort
+	** NOTE: This is a port of Orson Peters' pattern-defeating quicksort (pdqsort, https://github.com/orlp/pdqsort).
+	**       Small partitions are insertion sorted, large ones use a ninther pivot and a branchless block partition
+	**       (BlockQuicksort) and if too many partitions come out badly unbalanced we fall back to heapsort, so the
+	**       worst case is O(n log n). Sorted, reverse sorted and many-equal-key inputs are detected and finish in close to O(n).
+	**       Since we don't know the element type, elements are only ever moved around by swapping them in place
 */
 
-int a_ctz_64(uint64_t x)
+#define QSORT_INSERTION_SORT_THRESHOLD     24  //partitions smaller than this are insertion sorted
+#define QSORT_NINTHER_THRESHOLD            128 //partitions larger than this use the median of 3 medians of 3 as the pivot
+#define QSORT_PARTIAL_INSERTION_SORT_LIMIT 8   //how many elements partial insertion sort can move before it gives up
+#define QSORT_BLOCK_SIZE                   64  //number of elements the branchless partition compares before doing any swaps
+
+// Most sorts are over pointers, u32/u64 keys or small structs made of those, so rather than always copying bytes we pick
+// the widest move that evenly divides itemSize once in QsortRun and QsortSwap switches on it (the branch always goes the same way)
+typedef enum QsortSwapKind_t QsortSwapKind_t;
+enum QsortSwapKind_t
 {
-	static const char debruijn64[64] =
-	{
-		0, 1, 2, 53, 3, 7, 54, 27, 4, 38, 41, 8, 34, 55, 48, 28,
-		62, 5, 39, 46, 44, 42, 22, 9, 24, 35, 59, 56, 49, 18, 29, 11,
-		63, 52, 6, 26, 37, 40, 33, 47, 61, 45, 43, 21, 23, 58, 17, 10,
-		51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12
-	};
-	return debruijn64[((x & -x) * 0x022FDD63CC95386Dull) >> 58];
+	QsortSwapKind_Bytes = 0, //any itemSize, swaps through a 64-byte buffer
+	QsortSwapKind_U32,       //itemSize == 4
+	QsortSwapKind_U64,       //itemSize == 8
+	QsortSwapKind_U32s,      //itemSize is a multiple of 4
+	QsortSwapKind_U64s,      //itemSize is a multiple of 8
+	#if STD_SIMD_ENABLED
+	QsortSwapKind_V128,      //itemSize == 16
+	QsortSwapKind_V128s,     //itemSize is a multiple of 16
+	#endif
+};
+
+// The array doesn't have to be aligned to itemSize (or at all) so all of the word-sized moves are unaligned
+typedef uint32_t __attribute__((__may_alias__, __aligned__(1))) a_qsort_u32;
+typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) a_qsort_u64;
+
+typedef struct QsortContext_t QsortContext_t;
+struct QsortContext_t
+{
+	size_t itemSize;
+	QsortSwapKind_t swapKind;
+	// qsort's comparison function is called directly rather than through a wrapper, compareFuncEx is only used when compareFunc is null
+	StdCompareFunc_f* compareFunc;
+	StdCompareFuncEx_f* compareFuncEx;
+	void* compareArg;
+};
+
+static inline bool QsortLess(const QsortContext_t* context, const unsigned char* left, const unsigned char* right)
+{
+	if (context->compareFunc != nullptr) { return (context->compareFunc(left, right) < 0); }
+	else { return (context->compareFuncEx(left, right, context->compareArg) < 0); }
 }
 
-int pntz(size_t array[2])
+static QsortSwapKind_t QsortPickSwapKind(size_t itemSize)
 {
-	int dValue = a_ctz_64(array[0] - 1);
-	if (dValue != 0 || (dValue = 8 * sizeof(size_t) + a_ctz_64(array[1])) != (8 * sizeof(size_t)))
+	#if STD_SIMD_ENABLED
+	if (itemSize == 16) { return QsortSwapKind_V128; }
+	if ((itemSize % 16) == 0) { return QsortSwapKind_V128s; }
+	#endif
+	if (itemSize == 4) { return QsortSwapKind_U32; }
+	if (itemSize == 8) { return QsortSwapKind_U64; }
+	if ((itemSize % 8) == 0) { return QsortSwapKind_U64s; }
+	if ((itemSize % 4) == 0) { return QsortSwapKind_U32s; }
+	return QsortSwapKind_Bytes;
+}
+
+static inline void QsortSwap(const QsortContext_t* context, unsigned char* left, unsigned char* right)
+{
+	switch (context->swapKind)
 	{
-		return dValue;
+		case QsortSwapKind_U32:
+		{
+			uint32_t temp = *(a_qsort_u32*)left;
+			*(a_qsort_u32*)left = *(a_qsort_u32*)right;
+			*(a_qsort_u32*)right = temp;
+		} break;
+		case QsortSwapKind_U64:
+		{
+			uint64_t temp = *(a_qsort_u64*)left;
+			*(a_qsort_u64*)left = *(a_qsort_u64*)right;
+			*(a_qsort_u64*)right = temp;
+		} break;
+		case QsortSwapKind_U32s:
+		{
+			for (size_t offset = 0; offset < context->itemSize; offset += sizeof(uint32_t))
+			{
+				uint32_t temp = *(a_qsort_u32*)(left + offset);
+				*(a_qsort_u32*)(left + offset) = *(a_qsort_u32*)(right + offset);
+				*(a_qsort_u32*)(right + offset) = temp;
+			}
+		} break;
+		case QsortSwapKind_U64s:
+		{
+			for (size_t offset = 0; offset < context->itemSize; offset += sizeof(uint64_t))
+			{
+				uint64_t temp = *(a_qsort_u64*)(left + offset);
+				*(a_qsort_u64*)(left + offset) = *(a_qsort_u64*)(right + offset);
+				*(a_qsort_u64*)(right + offset) = temp;
+			}
+		} break;
+		#if STD_SIMD_ENABLED
+		case QsortSwapKind_V128:
+		{
+			StdU32x4U_t temp = *(StdU32x4U_t*)left;
+			*(StdU32x4U_t*)left = *(StdU32x4U_t*)right;
+			*(StdU32x4U_t*)right = temp;
+		} break;
+		case QsortSwapKind_V128s:
+		{
+			for (size_t offset = 0; offset < context->itemSize; offset += STD_SIMD_SIZE)
+			{
+				StdU32x4U_t temp = *(StdU32x4U_t*)(left + offset);
+				*(StdU32x4U_t*)(left + offset) = *(StdU32x4U_t*)(right + offset);
+				*(StdU32x4U_t*)(right + offset) = temp;
+			}
+		} break;
+		#endif
+		default:
+		{
+			unsigned char tempBuffer[64];
+			for (size_t offset = 0; offset < context->itemSize; offset += sizeof(tempBuffer))
+			{
+				size_t chunkSize = ((context->itemSize - offset < sizeof(tempBuffer)) ? (context->itemSize - offset) : sizeof(tempBuffer));
+				memcpy(&tempBuffer[0], left + offset, chunkSize);
+				memcpy(left + offset, right + offset, chunkSize);
+				memcpy(right + offset, &tempBuffer[0], chunkSize);
+			}
+		} break;
 	}
-	return 0;
 }
 
-void cycle(size_t width, unsigned char* pntrArray[], int arraySize)
+static inline void QsortSort2(const QsortContext_t* context, unsigned char* first, unsigned char* second)
 {
-	unsigned char tmp[256];
-	size_t word;
-	int index;
+	if (QsortLess(context, second, first)) { QsortSwap(context, first, second); }
+}
 
-	if (arraySize < 2) { return; }
+static inline void QsortSort3(const QsortContext_t* context, unsigned char* first, unsigned char* second, unsigned char* third)
+{
+	QsortSort2(context, first, second);
+	QsortSort2(context, second, third);
+	QsortSort2(context, first, second);
+}
 
-	pntrArray[arraySize] = tmp;
-	while(width)
+// +--------------------------------------------------------------+
+// |                        Insertion Sort                        |
+// +--------------------------------------------------------------+
+static void QsortInsertionSort(const QsortContext_t* context, unsigned char* begin, unsigned char* end)
+{
+	size_t itemSize = context->itemSize;
+	if (begin == end) { return; }
+	for (unsigned char* current = begin + itemSize; current != end; current += itemSize)
 	{
-		word = ((sizeof(tmp) < width) ? sizeof(tmp) : width);
-		memcpy(pntrArray[arraySize], pntrArray[0], word);
-		for(index = 0; index < arraySize; index++)
+		for (unsigned char* sift = current; sift != begin && QsortLess(context, sift, sift - itemSize); sift -= itemSize)
 		{
-			memcpy(pntrArray[index], pntrArray[index + 1], word);
-			pntrArray[index] += word;
+			QsortSwap(context, sift, sift - itemSize);
 		}
-		width -= word;
 	}
 }
 
-// shiftLeft() and shiftRight() need numBits > 0
-void shiftLeft(size_t array[2], int numBits)
+// Same as QsortInsertionSort but assumes the element before begin is less than or equal to everything in the range, so it acts as a sentinel
+static void QsortUnguardedInsertionSort(const QsortContext_t* context, unsigned char* begin, unsigned char* end)
 {
-	if (numBits >= 8 * sizeof(size_t))
+	size_t itemSize = context->itemSize;
+	if (begin == end) { return; }
+	for (unsigned char* current = begin + itemSize; current != end; current += itemSize)
 	{
-		numBits -= (8 * sizeof(size_t));
-		array[1] = array[0];
-		array[0] = 0;
+		for (unsigned char* sift = current; QsortLess(context, sift, sift - itemSize); sift -= itemSize)
+		{
+			QsortSwap(context, sift, sift - itemSize);
+		}
 	}
-	array[1] <<= numBits;
-	array[1] |= (array[0] >> ((sizeof(size_t) * 8) - numBits));
-	array[0] <<= numBits;
 }
 
-void shiftRight(size_t array[2], int numBits)
+// Attempts an insertion sort but gives up (returning false) once more than QSORT_PARTIAL_INSERTION_SORT_LIMIT elements have been moved
+static bool QsortPartialInsertionSort(const QsortContext_t* context, unsigned char* begin, unsigned char* end)
 {
-	if (numBits >= 8 * sizeof(size_t))
+	size_t itemSize = context->itemSize;
+	size_t numMoved = 0;
+	if (begin == end) { return true; }
+	for (unsigned char* current = begin + itemSize; current != end; current += itemSize)
 	{
-		numBits -= (8 * sizeof(size_t));
-		array[0] = array[1];
-		array[1] = 0;
+		unsigned char* sift = current;
+		for (; sift != begin && QsortLess(context, sift, sift - itemSize); sift -= itemSize)
+		{
+			QsortSwap(context, sift, sift - itemSize);
+		}
+		numMoved += (size_t)(current - sift) / itemSize;
+		if (numMoved > QSORT_PARTIAL_INSERTION_SORT_LIMIT) { return false; }
 	}
-	array[0] >>= numBits;
-	array[0] |= (array[1] << ((sizeof(size_t) * 8) - numBits));
-	array[1] >>= numBits;
+	return true;
 }
 
-void sift(unsigned char* headPntr, size_t itemSize, StdCompareFuncEx_f* compareFunc, void* argPntr, int pshift, size_t wordArray[])
+// +--------------------------------------------------------------+
+// |                           Heapsort                           |
+// +--------------------------------------------------------------+
+static void QsortSiftDown(const QsortContext_t* context, unsigned char* base, size_t rootIndex, size_t numItems)
 {
-	unsigned char* rightPntr;
-	unsigned char* leftPntr;
-	unsigned char* array[(14 * sizeof(size_t)) + 1];
-	int index = 1;
+	size_t itemSize = context->itemSize;
+	while (true)
+	{
+		size_t childIndex = (rootIndex * 2) + 1;
+		if (childIndex >= numItems) { break; }
+		if (childIndex + 1 < numItems && QsortLess(context, base + (childIndex * itemSize), base + ((childIndex + 1) * itemSize))) { childIndex++; }
+		if (!QsortLess(context, base + (rootIndex * itemSize), base + (childIndex * itemSize))) { break; }
+		QsortSwap(context, base + (rootIndex * itemSize), base + (childIndex * itemSize));
+		rootIndex = childIndex;
+	}
+}
 
-	array[0] = headPntr;
-	while (pshift > 1)
+static void QsortHeapSort(const QsortContext_t* context, unsigned char* begin, unsigned char* end)
+{
+	size_t numItems = (size_t)(end - begin) / context->itemSize;
+	for (size_t rootIndex = numItems / 2; rootIndex > 0; rootIndex--) { QsortSiftDown(context, begin, rootIndex - 1, numItems); }
+	for (size_t lastIndex = numItems - 1; lastIndex > 0; lastIndex--)
 	{
-		rightPntr = headPntr - itemSize;
-		leftPntr = headPntr - itemSize - wordArray[pshift - 2];
+		QsortSwap(context, begin, begin + (lastIndex * context->itemSize));
+		QsortSiftDown(context, begin, 0, lastIndex);
+	}
+}
 
-		if (compareFunc(array[0], leftPntr, argPntr) >= 0 && compareFunc(array[0], rightPntr, argPntr) >= 0)
+// +--------------------------------------------------------------+
+// |                         Partitioning                         |
+// +--------------------------------------------------------------+
+// Partitions [begin, end) around the pivot at *begin. Elements equal to the pivot go to the right. Returns where the pivot ended
+// up and sets alreadyPartitionedOut if no elements had to be swapped. Assumes the pivot was picked with a median of at least 3
+// so there is an element >= pivot somewhere after begin (this lets the first scans run without bounds checks).
+// Rather than branching on every comparison, blocks of up to QSORT_BLOCK_SIZE elements from each side are compared first and the
+// offsets of elements on the wrong side are written out unconditionally (only the count depends on the result). Then the two lists are swapped pairwise
+static unsigned char* QsortPartitionRight(const QsortContext_t* context, unsigned char* begin, unsigned char* end, bool* alreadyPartitionedOut)
+{
+	size_t itemSize = context->itemSize;
+	unsigned char* pivot = begin;
+	unsigned char* first = begin;
+	unsigned char* last = end;
+	
+	do { first += itemSize; } while (QsortLess(context, first, pivot));
+	if (first - itemSize == begin)
+	{
+		while (first < last) { last -= itemSize; if (QsortLess(context, last, pivot)) { break; } }
+	}
+	else
+	{
+		do { last -= itemSize; } while (!QsortLess(context, last, pivot));
+	}
+	
+	*alreadyPartitionedOut = (first >= last);
+	if (!*alreadyPartitionedOut)
+	{
+		QsortSwap(context, first, last);
+		first += itemSize;
+		
+		uint8_t leftOffsets[QSORT_BLOCK_SIZE];
+		uint8_t rightOffsets[QSORT_BLOCK_SIZE];
+		unsigned char* leftOffsetsBase = first;
+		unsigned char* rightOffsetsBase = last;
+		size_t numLeft = 0, numRight = 0, leftStart = 0, rightStart = 0;
+		while (first < last)
 		{
-			break;
+			// Fill up whichever offset buffers are empty, if both are empty and there's less than 2 blocks left the remaining elements are split between them
+			size_t numUnknown = (size_t)(last - first) / itemSize;
+			size_t leftSplit = ((numLeft == 0) ? ((numRight == 0) ? (numUnknown / 2) : numUnknown) : 0);
+			size_t rightSplit = ((numRight == 0) ? (numUnknown - leftSplit) : 0);
+			if (leftSplit > QSORT_BLOCK_SIZE) { leftSplit = QSORT_BLOCK_SIZE; }
+			if (rightSplit > QSORT_BLOCK_SIZE) { rightSplit = QSORT_BLOCK_SIZE; }
+			
+			for (size_t iIndex = 0; iIndex < leftSplit; iIndex++)
+			{
+				leftOffsets[numLeft] = (uint8_t)iIndex;
+				numLeft += !QsortLess(context, first, pivot);
+				first += itemSize;
+			}
+			for (size_t iIndex = 0; iIndex < rightSplit; iIndex++)
+			{
+				last -= itemSize;
+				rightOffsets[numRight] = (uint8_t)(iIndex + 1);
+				numRight += QsortLess(context, last, pivot);
+			}
+			
+			size_t numSwaps = ((numLeft < numRight) ? numLeft : numRight);
+			for (size_t sIndex = 0; sIndex < numSwaps; sIndex++)
+			{
+				QsortSwap(context, leftOffsetsBase + (leftOffsets[leftStart + sIndex] * itemSize), rightOffsetsBase - (rightOffsets[rightStart + sIndex] * itemSize));
+			}
+			numLeft -= numSwaps;
+			numRight -= numSwaps;
+			leftStart += numSwaps;
+			rightStart += numSwaps;
+			if (numLeft == 0) { leftStart = 0; leftOffsetsBase = first; }
+			if (numRight == 0) { rightStart = 0; rightOffsetsBase = last; }
 		}
 		
-		if (compareFunc(leftPntr, rightPntr, argPntr) >= 0)
+		// Whichever side still has offsets left gets those elements swapped over to the other side of the boundary
+		if (numLeft != 0)
 		{
-			array[index++] = leftPntr;
-			headPntr = leftPntr;
-			pshift -= 1;
+			while (numLeft-- > 0)
+			{
+				last -= itemSize;
+				QsortSwap(context, leftOffsetsBase + (leftOffsets[leftStart + numLeft] * itemSize), last);
+			}
+			first = last;
 		}
-		else
+		if (numRight != 0)
 		{
-			array[index++] = rightPntr;
-			headPntr = rightPntr;
-			pshift -= 2;
+			while (numRight-- > 0)
+			{
+				QsortSwap(context, rightOffsetsBase - (rightOffsets[rightStart + numRight] * itemSize), first);
+				first += itemSize;
+			}
+			last = first;
 		}
 	}
 	
-	cycle(itemSize, array, index);
+	unsigned char* pivotPos = first - itemSize;
+	if (pivotPos != begin) { QsortSwap(context, begin, pivotPos); }
+	return pivotPos;
 }
 
-void trinkle(unsigned char* headPntr, size_t itemSize, StdCompareFuncEx_f* compareFunc, void* compareFuncRaw, size_t twoWords[2], int pshift, int trusty, size_t wordArray[])
+// Like QsortPartitionRight but elements equal to the pivot go to the left. This is used when the pivot is equal to the element just
+// before begin (the previous pivot) which means everything equal to it can be put in place right away. Returns where the pivot ended up
+static unsigned char* QsortPartitionLeft(const QsortContext_t* context, unsigned char* begin, unsigned char* end)
 {
-	unsigned char* stepson;
-	unsigned char* rightPntr;
-	unsigned char* leftPntr;
-	size_t twoWordsLocal[2];
-	unsigned char* array[(14 * sizeof(size_t)) + 1];
-	int index = 1;
-	int trail;
-
-	twoWordsLocal[0] = twoWords[0];
-	twoWordsLocal[1] = twoWords[1];
+	size_t itemSize = context->itemSize;
+	unsigned char* pivot = begin;
+	unsigned char* first = begin;
+	unsigned char* last = end;
 
-	array[0] = headPntr;
-	while(twoWordsLocal[0] != 1 || twoWordsLocal[1] != 0)
+	do { last -= itemSize; } while (QsortLess(context, pivot, last));
+	if (last + itemSize == end)
 	{
-		stepson = headPntr - wordArray[pshift];
-		if (compareFunc(stepson, array[0], compareFuncRaw) <= 0)
-		{
-			break;
-		}
-		if (!trusty && pshift > 1)
-		{
-			rightPntr = headPntr - itemSize;
-			leftPntr = headPntr - itemSize - wordArray[pshift - 2];
-			if (compareFunc(rightPntr, stepson, compareFuncRaw) >= 0 || compareFunc(leftPntr, stepson, compareFuncRaw) >= 0)
-			{
-				break;
-			}
-		}
-
-		array[index++] = stepson;
-		headPntr = stepson;
-		trail = pntz(twoWordsLocal);
-		shiftRight(twoWordsLocal, trail);
-		pshift += trail;
-		trusty = 0;
+		while (first < last) { first += itemSize; if (QsortLess(context, pivot, first)) { break; } }
+	}
+	else
+	{
+		do { first += itemSize; } while (!QsortLess(context, pivot, first));
 	}
 	
-	if (!trusty)
+	while (first < last)
 	{
-		cycle(itemSize, array, index);
-		sift(headPntr, itemSize, compareFunc, compareFuncRaw, pshift, wordArray);
+		QsortSwap(context, first, last);
+		do { last -= itemSize; } while (QsortLess(context, pivot, last));
+		do { first += itemSize; } while (!QsortLess(context, pivot, first));
 	}
+	
+	if (last != begin) { QsortSwap(context, begin, last); }
+	return last;
 }
 
-void __qsort_r(void* basePntr, size_t numItems, size_t itemSize, StdCompareFuncEx_f* compareFunc, void* compareFuncRaw)
+// +--------------------------------------------------------------+
+// |                          Main Loop                           |
+// +--------------------------------------------------------------+
+// leftmost is true if begin is the start of the whole array, otherwise the element before begin is <= everything in the range.
+// We recurse into the smaller side of each partition and loop on the larger one so the recursion depth is at most log2(numItems)
+static void QsortLoop(const QsortContext_t* context, unsigned char* begin, unsigned char* end, uint32_t badAllowed, bool leftmost)
 {
-	size_t localStorage[12 * sizeof(size_t)];
-	size_t index;
-	size_t totalSize = (itemSize * numItems);
-	unsigned char* headPntr;
-	unsigned char* highPntr;
-	size_t twoWords[2] = { 1, 0 };
-	int pshift = 1;
-	int trail;
-
-	if (!totalSize) { return; }
-
-	headPntr = basePntr;
-	highPntr = headPntr + totalSize - itemSize;
-
-	// Precompute Leonardo numbers, scaled by element itemSize
-	localStorage[0] = itemSize;
-	localStorage[1] = itemSize;
-	for (index = 2; (localStorage[index] = localStorage[index - 2] + localStorage[index - 1] + itemSize) < totalSize; index++) { }
-
-	while (headPntr < highPntr)
+	size_t itemSize = context->itemSize;
+	while (true)
 	{
-		if ((twoWords[0] & 3) == 3)
+		size_t numItems = (size_t)(end - begin) / itemSize;
+		if (numItems < QSORT_INSERTION_SORT_THRESHOLD)
 		{
-			sift(headPntr, itemSize, compareFunc, compareFuncRaw, pshift, localStorage);
-			shiftRight(twoWords, 2);
-			pshift += 2;
+			if (leftmost) { QsortInsertionSort(context, begin, end); }
+			else { QsortUnguardedInsertionSort(context, begin, end); }
+			return;
 		}
-		else
+		
+		// Choose a pivot and move it to begin
+		size_t halfNumItems = numItems / 2;
+		unsigned char* middle = begin + (halfNumItems * itemSize);
+		if (numItems > QSORT_NINTHER_THRESHOLD)
 		{
-			if (localStorage[pshift - 1] >= (highPntr - headPntr))
-			{
-				trinkle(headPntr, itemSize, compareFunc, compareFuncRaw, twoWords, pshift, 0, localStorage);
-			}
-			else
-			{
-				sift(headPntr, itemSize, compareFunc, compareFuncRaw, pshift, localStorage);
-			}
+			QsortSort3(context, begin, middle, end - itemSize);
+			QsortSort3(context, begin + itemSize, middle - itemSize, end - (2 * itemSize));
+			QsortSort3(context, begin + (2 * itemSize), middle + itemSize, end - (3 * itemSize));
+			QsortSort3(context, middle - itemSize, middle, middle + itemSize);
+			QsortSwap(context, begin, middle);
+		}
+		else { QsortSort3(context, middle, begin, end - itemSize); }
+		
+		// If the pivot is equal to the previous pivot (the element before begin) then this range has lots of equal elements.
+		// Put all of them on the left, they're already in their final spot, and only keep going with the larger ones
+		if (!leftmost && !QsortLess(context, begin - itemSize, begin))
+		{
+			begin = QsortPartitionLeft(context, begin, end) + itemSize;
+			continue;
+		}
+		
+		bool alreadyPartitioned = false;
+		unsigned char* pivotPos = QsortPartitionRight(context, begin, end, &alreadyPartitioned);
+		size_t leftSize = (size_t)(pivotPos - begin) / itemSize;
+		size_t rightSize = (size_t)(end - (pivotPos + itemSize)) / itemSize;
 
-			if (pshift == 1)
+		if (leftSize < numItems / 8 || rightSize < numItems / 8)
+		{
+			// Badly unbalanced, after too many of these we switch to heapsort. Otherwise shuffle some elements around to break up
+			// whatever pattern caused this so the next pivot on each side is more likely to be a good one
+			if (--badAllowed == 0) { QsortHeapSort(context, begin, end); return; }
+			if (leftSize >= QSORT_INSERTION_SORT_THRESHOLD)
 			{
-				shiftLeft(twoWords, 1);
-				pshift = 0;
+				size_t quarter = leftSize / 4;
+				QsortSwap(context, begin, begin + (quarter * itemSize));
+				QsortSwap(context, pivotPos - itemSize, pivotPos - (quarter * itemSize));
+				if (leftSize > QSORT_NINTHER_THRESHOLD)
+				{
+					QsortSwap(context, begin + itemSize, begin + ((quarter + 1) * itemSize));
+					QsortSwap(context, begin + (2 * itemSize), begin + ((quarter + 2) * itemSize));
+					QsortSwap(context, pivotPos - (2 * itemSize), pivotPos - ((quarter + 1) * itemSize));
+					QsortSwap(context, pivotPos - (3 * itemSize), pivotPos - ((quarter + 2) * itemSize));
+				}
 			}
-			else
+			if (rightSize >= QSORT_INSERTION_SORT_THRESHOLD)
 			{
-				shiftLeft(twoWords, pshift - 1);
-				pshift = 1;
+				size_t quarter = rightSize / 4;
+				QsortSwap(context, pivotPos + itemSize, pivotPos + ((quarter + 1) * itemSize));
+				QsortSwap(context, end - itemSize, end - (quarter * itemSize));
+				if (rightSize > QSORT_NINTHER_THRESHOLD)
+				{
+					QsortSwap(context, pivotPos + (2 * itemSize), pivotPos + ((quarter + 2) * itemSize));
+					QsortSwap(context, pivotPos + (3 * itemSize), pivotPos + ((quarter + 3) * itemSize));
+					QsortSwap(context, end - (2 * itemSize), end - ((quarter + 1) * itemSize));
+					QsortSwap(context, end - (3 * itemSize), end - ((quarter + 2) * itemSize));
+				}
 			}
 		}
+		else if (alreadyPartitioned)
+		{
+			// Nothing moved, the input might already be (mostly) sorted so try an insertion sort that gives up quickly if it's not
+			if (QsortPartialInsertionSort(context, begin, pivotPos) && QsortPartialInsertionSort(context, pivotPos + itemSize, end)) { return; }
+		}
 
-		twoWords[0] |= 1;
-		headPntr += itemSize;
-	}
-
-	trinkle(headPntr, itemSize, compareFunc, compareFuncRaw, twoWords, pshift, 0, localStorage);
-
-	while (pshift != 1 || twoWords[0] != 1 || twoWords[1] != 0)
-	{
-		if (pshift <= 1)
+		if (leftSize < rightSize)
 		{
-			trail = pntz(twoWords);
-			shiftRight(twoWords, trail);
-			pshift += trail;
+			QsortLoop(context, begin, pivotPos, badAllowed, leftmost);
+			begin = pivotPos + itemSize;
+			leftmost = false;
 		}
 		else
 		{
-			shiftLeft(twoWords, 2);
-			pshift -= 2;
-			twoWords[0] ^= 7;
-			shiftRight(twoWords, 1);
-			trinkle((headPntr - localStorage[pshift] - itemSize), itemSize, compareFunc, compareFuncRaw, twoWords, pshift + 1, 1, localStorage);
-			shiftLeft(twoWords, 1);
-			twoWords[0] |= 1;
-			trinkle(headPntr - itemSize, itemSize, compareFunc, compareFuncRaw, twoWords, pshift, 1, localStorage);
+			QsortLoop(context, pivotPos + itemSize, end, badAllowed, false);
+			end = pivotPos;
 		}
-		headPntr -= itemSize;
 	}
 }
 
-int WrapperCompareFunc(const void* left, const void* right, void* compareFunc)
+static void QsortRun(QsortContext_t* context, void* basePntr, size_t numItems)
+{
+	if (numItems < 2 || context->itemSize == 0) { return; }
+	context->swapKind = QsortPickSwapKind(context->itemSize);
+	uint32_t badAllowed = 32 - __builtin_clz((uint32_t)numItems); //floor(log2(numItems)) + 1
+	unsigned char* begin = (unsigned char*)basePntr;
+	QsortLoop(context, begin, begin + (numItems * context->itemSize), badAllowed, true);
+}
+
+void __qsort_r(void* basePntr, size_t numItems, size_t itemSize, StdCompareFuncEx_f* compareFunc, void* compareFuncRaw)
 {
-	return ((StdCompareFunc_f*)compareFunc)(left, right);
+	QsortContext_t context = { itemSize, QsortSwapKind_Bytes, nullptr, compareFunc, compareFuncRaw };
+	QsortRun(&context, basePntr, numItems);
 }
@@ -20,16 +20,138 @@ Description:
 #define PIG_WASM_STD_USE_BUILTIN_WCSLEN  0 //calls itself
 
 #define WORD_CONTAINS_ZERO(word) ((word)-((size_t)-1/UCHAR_MAX) & ~(word) & (((size_t)-1/UCHAR_MAX) * (UCHAR_MAX/2+1)))
+#define WIDE_WORD_CONTAINS_ZERO(word) (((word) - 0x0000000100000001ULL) & ~(word) & 0x8000000080000000ULL) //two 32-bit wchar_t in a uint64_t
 
 #define MAX(left, right) ((left) > (right) ? (left) : (right))
 #define MIN(left, right) ((left) < (right) ? (left) : (right))
 
 typedef size_t __attribute__((__may_alias__)) a_size_t;
+typedef uint64_t __attribute__((__may_alias__)) a_wide_u64;
 #define SIZEOF_A_SIZE_T sizeof(a_size_t)
 
+// memory.copy and memory.fill have a fixed cost on most engines (they call out of the jitted code and do bounds checks)
+// that outweighs the actual work for small sizes. When the builtins are used, copies and fills up to these sizes are done
+// inline with a few overlapping loads/stores instead. RunMemoryBenchmarks in the test app compares the two ways at every size
+// up to 64 so these can be tuned per-project. The inline path handles at most 64 bytes so these can't be set any higher.
+// NOTE: In V8 (node 20) the inline path was 2-7x faster than memory.copy/memory.fill at every size from 1 to 64 (about 1-4ns
+//       vs 6.4-11ns per call) so there's no crossover below the cap and both default to 64. See the README for the numbers
+#ifndef PIG_WASM_STD_MEMCPY_INLINE_MAX
+#define PIG_WASM_STD_MEMCPY_INLINE_MAX 64
+#endif
+#ifndef PIG_WASM_STD_MEMSET_INLINE_MAX
+#define PIG_WASM_STD_MEMSET_INLINE_MAX 64
+#endif
+#if PIG_WASM_STD_MEMCPY_INLINE_MAX > 64 || PIG_WASM_STD_MEMSET_INLINE_MAX > 64
+#error PIG_WASM_STD_MEMCPY_INLINE_MAX and PIG_WASM_STD_MEMSET_INLINE_MAX can't be more than 64
+#endif
+
+typedef uint16_t __attribute__((__may_alias__, __aligned__(1))) a_u16_unaligned;
+typedef uint32_t __attribute__((__may_alias__, __aligned__(1))) a_u32_unaligned;
+typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) a_u64_unaligned;
+
+// numBytes must be 64 or less. Every load happens before any store so this is also safe when dest and source overlap (memmove).
+// Each size range is covered by two (or four) loads/stores from the front and back that overlap in the middle
+static inline void SmallMemCopy(unsigned char* dest, const unsigned char* source, size_t numBytes)
+{
+	if (numBytes >= 16)
+	{
+		#if STD_SIMD_ENABLED
+		StdU8x16U_t firstBlock = *(const StdU8x16U_t*)source;
+		StdU8x16U_t lastBlock = *(const StdU8x16U_t*)(source + numBytes - 16);
+		if (numBytes > 32)
+		{
+			StdU8x16U_t secondBlock = *(const StdU8x16U_t*)(source + 16);
+			StdU8x16U_t thirdBlock = *(const StdU8x16U_t*)(source + numBytes - 32);
+			*(StdU8x16U_t*)(dest + 16) = secondBlock;
+			*(StdU8x16U_t*)(dest + numBytes - 32) = thirdBlock;
+		}
+		*(StdU8x16U_t*)dest = firstBlock;
+		*(StdU8x16U_t*)(dest + numBytes - 16) = lastBlock;
+		#else
+		uint64_t words[8];
+		uint32_t numHalfWords = ((numBytes > 32) ? 4 : 2);
+		for (uint32_t wIndex = 0; wIndex < numHalfWords; wIndex++)
+		{
+			words[wIndex] = *(const a_u64_unaligned*)(source + wIndex*8);
+			words[numHalfWords + wIndex] = *(const a_u64_unaligned*)(source + numBytes - (numHalfWords - wIndex)*8);
+		}
+		for (uint32_t wIndex = 0; wIndex < numHalfWords; wIndex++)
+		{
+			*(a_u64_unaligned*)(dest + wIndex*8) = words[wIndex];
+			*(a_u64_unaligned*)(dest + numBytes - (numHalfWords - wIndex)*8) = words[numHalfWords + wIndex];
+		}
+		#endif
+	}
+	else if (numBytes >= 8)
+	{
+		uint64_t firstWord = *(const a_u64_unaligned*)source;
+		uint64_t lastWord = *(const a_u64_unaligned*)(source + numBytes - 8);
+		*(a_u64_unaligned*)dest = firstWord;
+		*(a_u64_unaligned*)(dest + numBytes - 8) = lastWord;
+	}
+	else if (numBytes >= 4)
+	{
+		uint32_t firstWord = *(const a_u32_unaligned*)source;
+		uint32_t lastWord = *(const a_u32_unaligned*)(source + numBytes - 4);
+		*(a_u32_unaligned*)dest = firstWord;
+		*(a_u32_unaligned*)(dest + numBytes - 4) = lastWord;
+	}
+	else if (numBytes >= 2)
+	{
+		uint16_t firstWord = *(const a_u16_unaligned*)source;
+		uint16_t lastWord = *(const a_u16_unaligned*)(source + numBytes - 2);
+		*(a_u16_unaligned*)dest = firstWord;
+		*(a_u16_unaligned*)(dest + numBytes - 2) = lastWord;
+	}
+	else if (numBytes == 1) { *dest = *source; }
+}
+
+// numBytes must be 64 or less
+static inline void SmallMemSet(unsigned char* dest, uint8_t value, size_t numBytes)
+{
+	uint64_t value64 = 0x0101010101010101ULL * value;
+	if (numBytes >= 16)
+	{
+		#if STD_SIMD_ENABLED
+		StdU8x16_t valueVec = StdSimdSplatU8(value);
+		if (numBytes > 32)
+		{
+			*(StdU8x16U_t*)(dest + 16) = valueVec;
+			*(StdU8x16U_t*)(dest + numBytes - 32) = valueVec;
+		}
+		*(StdU8x16U_t*)dest = valueVec;
+		*(StdU8x16U_t*)(dest + numBytes - 16) = valueVec;
+		#else
+		uint32_t numHalfWords = ((numBytes > 32) ? 4 : 2);
+		for (uint32_t wIndex = 0; wIndex < numHalfWords; wIndex++)
+		{
+			*(a_u64_unaligned*)(dest + wIndex*8) = value64;
+			*(a_u64_unaligned*)(dest + numBytes - (wIndex+1)*8) = value64;
+		}
+		#endif
+	}
+	else if (numBytes >= 8)
+	{
+		*(a_u64_unaligned*)dest = value64;
+		*(a_u64_unaligned*)(dest + numBytes - 8) = value64;
+	}
+	else if (numBytes >= 4)
+	{
+		*(a_u32_unaligned*)dest = (uint32_t)value64;
+		*(a_u32_unaligned*)(dest + numBytes - 4) = (uint32_t)value64;
+	}
+	else if (numBytes >= 2)
+	{
+		*(a_u16_unaligned*)dest = (uint16_t)value64;
+		*(a_u16_unaligned*)(dest + numBytes - 2) = (uint16_t)value64;
+	}
+	else if (numBytes == 1) { *dest = value; }
+}
+
 void* _memset(void* pntr, int value, size_t numBytes)
 {
 	#if PIG_WASM_STD_USE_BUILTIN_MEMSET
+	if (numBytes <= PIG_WASM_STD_MEMSET_INLINE_MAX) { SmallMemSet((unsigned char*)pntr, (uint8_t)value, numBytes); return pntr; }
 	// Basically converts to memory.fill instruction
 	return __builtin_memset(pntr, value, numBytes);
 	#else
@@ -118,6 +240,51 @@ int memcmp(const void* left, const void* right, size_t numBytes)
 	return __builtin_memcmp(left, right, numBytes);
 	#else
 	const unsigned char *leftByte = left, *rightByte = right;
+	
+	// Unaligned loads are fine in wasm, we just have to make sure we never read past numBytes. When a block (or word)
+	// differs, ctz on the mismatch mask finds the first differing byte and we return the difference of those two bytes
+	#if STD_SIMD_ENABLED
+	if (numBytes >= STD_SIMD_SIZE)
+	{
+		// The last block is moved back to end exactly at numBytes, overlapping bytes we already know are equal
+		const unsigned char* lastLeftBlock = leftByte + (numBytes - STD_SIMD_SIZE);
+		while (true)
+		{
+			uint32_t diffMask = StdSimdMask(*(const StdU8x16U_t*)leftByte != *(const StdU8x16U_t*)rightByte);
+			if (diffMask != 0)
+			{
+				uint32_t diffIndex = __builtin_ctz(diffMask);
+				return leftByte[diffIndex] - rightByte[diffIndex];
+			}
+			if (leftByte == lastLeftBlock) { return 0; }
+			size_t stepSize = MIN(STD_SIMD_SIZE, (size_t)(lastLeftBlock - leftByte));
+			leftByte += stepSize;
+			rightByte += stepSize;
+		}
+	}
+	#endif
+	
+	for (; numBytes >= sizeof(uint64_t); numBytes -= sizeof(uint64_t), leftByte += sizeof(uint64_t), rightByte += sizeof(uint64_t))
+	{
+		uint64_t diffBits = (*(const a_u64_unaligned*)leftByte ^ *(const a_u64_unaligned*)rightByte);
+		if (diffBits != 0)
+		{
+			uint32_t diffIndex = (uint32_t)__builtin_ctzll(diffBits) / 8; //little-endian, the lowest set bit is in the first differing byte
+			return leftByte[diffIndex] - rightByte[diffIndex];
+		}
+	}
+	if (numBytes >= sizeof(uint32_t))
+	{
+		uint32_t diffBits = (*(const a_u32_unaligned*)leftByte ^ *(const a_u32_unaligned*)rightByte);
+		if (diffBits != 0)
+		{
+			uint32_t diffIndex = (uint32_t)__builtin_ctz(diffBits) / 8;
+			return leftByte[diffIndex] - rightByte[diffIndex];
+		}
+		numBytes -= sizeof(uint32_t);
+		leftByte += sizeof(uint32_t);
+		rightByte += sizeof(uint32_t);
+	}
 	for (; (numBytes && *leftByte == *rightByte); numBytes--, leftByte++, rightByte++);
 	return (numBytes ? *leftByte - *rightByte : 0);
 	#endif
@@ -126,6 +293,7 @@ int memcmp(const void* left, const void* right, size_t numBytes)
 void* _memcpy(void* dest, const void* source, size_t numBytes)
 {
 	#if PIG_WASM_STD_USE_BUILTIN_MEMCPY
+	if (numBytes <= PIG_WASM_STD_MEMCPY_INLINE_MAX) { SmallMemCopy((unsigned char*)dest, (const unsigned char*)source, numBytes); return dest; }
 	// Basically converts to memory.copy instruction
 	return __builtin_memcpy(dest, source, numBytes);
 	#else
@@ -288,6 +456,7 @@ void* _memcpy(void* dest, const void* source, size_t numBytes)
 void* _memmove(void* dest, const void* source, size_t numBytes)
 {
 	#if PIG_WASM_STD_USE_BUILTIN_MEMMOVE
+	if (numBytes <= PIG_WASM_STD_MEMCPY_INLINE_MAX) { SmallMemCopy((unsigned char*)dest, (const unsigned char*)source, numBytes); return dest; }
 	return __builtin_memmove(dest, source, numBytes);
 	#else
 	char* destCharPntr = dest;
@@ -381,6 +550,10 @@ char* strstr(const char* haystack, const char* needle)
 	// Use faster algorithms for short needles
 	haystack = strchr(haystack, *needle);
 	if (!haystack || !needle[1]) { return (char *)haystack; }
+	#if STD_SIMD_ENABLED
+	// The SIMD filter is fast for any needle length, two-way only gets used if the filter stops being effective
+	return simd_strstr((void*)haystack, (void*)needle, strlen(needle));
+	#else
 	if (!haystack[1]) { return 0; }
 	if (!needle[2]) { return twobyte_strstr((void *)haystack, (void *)needle); }
 	if (!haystack[2]) { return 0; }
@@ -390,6 +563,177 @@ char* strstr(const char* haystack, const char* needle)
 	
 	return twoway_strstr((void *)haystack, (void *)needle);
 	#endif
+	#endif
+}
+
+// Like strstr but neither the haystack nor the needle need to be null-terminated
+void* memmem(const void* haystack, size_t haystackLen, const void* needle, size_t needleLen)
+{
+	const unsigned char* haystackPntr = haystack;
+	const unsigned char* needlePntr = needle;
+	if (needleLen == 0) { return (void*)haystack; }
+	if (needleLen > haystackLen) { return 0; }
+	
+	haystackPntr = memchr(haystackPntr, needlePntr[0], haystackLen);
+	if (!haystackPntr || needleLen == 1) { return (void*)haystackPntr; }
+	haystackLen -= (haystackPntr - (const unsigned char*)haystack);
+	if (needleLen > haystackLen) { return 0; }
+	
+	#if STD_SIMD_ENABLED
+	return simd_memmem(haystackPntr, haystackLen, needlePntr, needleLen);
+	#else
+	return twoway_memmem(haystackPntr, haystackPntr + haystackLen, needlePntr, needleLen);
+	#endif
+}
+
+#define span_BITOP(a,b,op) ((a)[(size_t)(b)/(8*sizeof *(a))] op (size_t)1<<((size_t)(b)%(8*sizeof *(a))))
+
+#if STD_SIMD_ENABLED
+// Character set membership for 16 bytes at a time (nibble lookup). Each byte is split into it's low and high nibble: the low
+// nibble picks a row from one of the two tables with i8x16.swizzle (lowTable for bytes < 0x80, highTable for the rest) and
+// each bit in that row says whether the byte with that high nibble (mod 8) is in the set. This is exact for any set of bytes
+typedef struct SimdCharSet_t SimdCharSet_t;
+struct SimdCharSet_t
+{
+	StdU8x16_t lowTable;
+	StdU8x16_t highTable;
+};
+
+static inline SimdCharSet_t SimdCharSetCreate(const unsigned char* charSet)
+{
+	SimdCharSet_t result;
+	uint8_t* lowTable = (uint8_t*)&result.lowTable;
+	uint8_t* highTable = (uint8_t*)&result.highTable;
+	result.lowTable = StdSimdSplatU8(0);
+	result.highTable = StdSimdSplatU8(0);
+	for (; *charSet; charSet++)
+	{
+		uint8_t* table = ((*charSet & 0x80) ? highTable : lowTable);
+		table[*charSet & 0x0F] |= (uint8_t)(1 << ((*charSet >> 4) & 0x07));
+	}
+	return result;
+}
+
+// Returns a bitmask with a bit set for each byte in block that is in the set (lane 0 is bit 0)
+static inline uint32_t SimdCharSetMatch(const SimdCharSet_t* charSet, StdU8x16_t block)
+{
+	const StdU8x16_t highNibbleBits = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+	StdU8x16_t lowNibbles = (block & 0x0F);
+	StdU8x16_t highByteMask = (StdU8x16_t)((StdI8x16_t)block < 0);
+	StdU8x16_t rows = ((StdSimdSwizzle(charSet->lowTable, lowNibbles) & ~highByteMask) | (StdSimdSwizzle(charSet->highTable, lowNibbles) & highByteMask));
+	return StdSimdMask((rows & StdSimdSwizzle(highNibbleBits, (block >> 4))) != 0);
+}
+
+// Length of the start of str made up entirely of bytes in the set (or entirely of bytes not in the set when inverted).
+// Uses the same aligned block walk as strlen, the terminator is never in the set so it always stops the span
+static size_t simd_span(const char* str, const SimdCharSet_t* charSet, bool inverted)
+{
+	uint32_t misalignment = ((uintptr_t)str & (STD_SIMD_SIZE-1));
+	const StdU8x16_t* blockPntr = StdSimdAlignDown(str);
+	uint32_t stopMask = (inverted ? (SimdCharSetMatch(charSet, *blockPntr) | StdSimdMask(*blockPntr == 0)) : (~SimdCharSetMatch(charSet, *blockPntr) & 0xFFFF));
+	stopMask >>= misalignment;
+	if (stopMask != 0) { return __builtin_ctz(stopMask); }
+	do
+	{
+		blockPntr++;
+		stopMask = (inverted ? (SimdCharSetMatch(charSet, *blockPntr) | StdSimdMask(*blockPntr == 0)) : (~SimdCharSetMatch(charSet, *blockPntr) & 0xFFFF));
+	} while (stopMask == 0);
+	return ((const char*)blockPntr - str) + __builtin_ctz(stopMask);
+}
+#endif //STD_SIMD_ENABLED
+
+// Returns the length of the start of str that only contains bytes from charSet
+size_t strspn(const char* str, const char* charSet)
+{
+	const char* startPntr = str;
+	if (!charSet[0]) { return 0; }
+	if (!charSet[1])
+	{
+		for (; *str == *charSet; str++) { }
+		return (str - startPntr);
+	}
+	
+	#if STD_SIMD_ENABLED
+	SimdCharSet_t simdCharSet = SimdCharSetCreate((const unsigned char*)charSet);
+	return simd_span(str, &simdCharSet, false);
+	#else
+	size_t byteset[32 / sizeof(size_t)] = { 0 };
+	for (; *charSet && span_BITOP(byteset, *(const unsigned char*)charSet, |=); charSet++) { }
+	for (; *str && span_BITOP(byteset, *(const unsigned char*)str, &); str++) { }
+	return (str - startPntr);
+	#endif
+}
+
+// Returns the length of the start of str that doesn't contain any bytes from charSet
+size_t strcspn(const char* str, const char* charSet)
+{
+	const char* startPntr = str;
+	if (!charSet[0] || !charSet[1]) { return (__strchrnul(str, *charSet) - startPntr); }
+	
+	#if STD_SIMD_ENABLED
+	SimdCharSet_t simdCharSet = SimdCharSetCreate((const unsigned char*)charSet);
+	return simd_span(str, &simdCharSet, true);
+	#else
+	size_t byteset[32 / sizeof(size_t)] = { 0 };
+	for (; *charSet && span_BITOP(byteset, *(const unsigned char*)charSet, |=); charSet++) { }
+	for (; *str && !span_BITOP(byteset, *(const unsigned char*)str, &); str++) { }
+	return (str - startPntr);
+	#endif
+}
+
+char* strpbrk(const char* str, const char* charSet)
+{
+	str += strcspn(str, charSet);
+	return (*str ? (char*)str : 0);
+}
+
+char* strrchr(const char* str, int targetChar)
+{
+	targetChar = (unsigned char)targetChar;
+	if (!targetChar) { return (char*)str + strlen(str); }
+	#if STD_SIMD_ENABLED
+	// Walk forward remembering the last block that had a match, matches after the terminator (in the last block) are masked off
+	StdU8x16_t targetVec = StdSimdSplatU8((uint8_t)targetChar);
+	uint32_t misalignment = ((uintptr_t)str & (STD_SIMD_SIZE-1));
+	const StdU8x16_t* blockPntr = StdSimdAlignDown(str);
+	const StdU8x16_t* lastMatchBlock = 0;
+	uint32_t lastMatchMask = 0;
+	uint32_t zeroMask = ((StdSimdMask(*blockPntr == 0) >> misalignment) << misalignment);
+	uint32_t matchMask = ((StdSimdMask(*blockPntr == targetVec) >> misalignment) << misalignment);
+	while (true)
+	{
+		if (zeroMask != 0) { matchMask &= (zeroMask ^ (zeroMask - 1)); } //only the bits up to the first terminator
+		if (matchMask != 0) { lastMatchBlock = blockPntr; lastMatchMask = matchMask; }
+		if (zeroMask != 0) { break; }
+		blockPntr++;
+		zeroMask = StdSimdMask(*blockPntr == 0);
+		matchMask = StdSimdMask(*blockPntr == targetVec);
+	}
+	return ((lastMatchBlock != 0) ? (char*)lastMatchBlock + (31 - __builtin_clz(lastMatchMask)) : 0);
+	#else
+	const char* charPntr = str + strlen(str);
+	while (charPntr > str) { charPntr--; if (*(unsigned char*)charPntr == targetChar) { return (char*)charPntr; } }
+	return 0;
+	#endif
+}
+
+// Returns the next token in str (or in the string from the last call if str is null) that is separated by bytes
+// from separators. The byte after the token is replaced with a terminator and savePntr is set to point after it
+char* strtok_r(char* str, const char* separators, char** savePntr)
+{
+	if (!str && !(str = *savePntr)) { return 0; }
+	str += strspn(str, separators);
+	if (!*str) { *savePntr = 0; return 0; }
+	*savePntr = str + strcspn(str, separators);
+	if (**savePntr) { *(*savePntr)++ = '\0'; }
+	else { *savePntr = 0; }
+	return str;
+}
+
+char* strtok(char* str, const char* separators)
+{
+	static char* savePntr = 0;
+	return strtok_r(str, separators, &savePntr);
 }
 
 int strcmp(const char* left, const char* right)
@@ -397,6 +741,33 @@ int strcmp(const char* left, const char* right)
 	#if PIG_WASM_STD_USE_BUILTIN_STRCMP
 	return __builtin_strcmp(left, right);
 	#else
+	#if STD_SIMD_ENABLED
+	// The two strings are rarely aligned the same way so we use unaligned loads, falling back to one byte at a time
+	// for the few blocks where a load would cross into the next page. A lane stops the search if the bytes differ or left hits the terminator
+	while (true)
+	{
+		if (StdSimdIsLoadPageSafe(left) && StdSimdIsLoadPageSafe(right))
+		{
+			StdU8x16U_t leftVec = *(const StdU8x16U_t*)left;
+			StdU8x16U_t rightVec = *(const StdU8x16U_t*)right;
+			uint32_t stopMask = StdSimdMask((leftVec != rightVec) | (leftVec == 0));
+			if (stopMask != 0)
+			{
+				uint32_t stopIndex = __builtin_ctz(stopMask);
+				return (((unsigned char*)left)[stopIndex] - ((unsigned char*)right)[stopIndex]);
+			}
+			left += STD_SIMD_SIZE;
+			right += STD_SIMD_SIZE;
+		}
+		else
+		{
+			for (uint32_t bIndex = 0; bIndex < STD_SIMD_SIZE; bIndex++, left++, right++)
+			{
+				if (*left != *right || !*left) { return (*(unsigned char*)left - *(unsigned char*)right); }
+			}
+		}
+	}
+	#endif
 	for (; *left == *right && *left; left++, right++);
 	return (*(unsigned char*)left - *(unsigned char*)right);
 	#endif
@@ -409,16 +780,371 @@ int strncmp(const char* left, const char* right, size_t numBytes)
 	#else
 	const unsigned char* leftPntr = (void*)left;
 	const unsigned char* rightPntr = (void*)right;
+	#if STD_SIMD_ENABLED
+	// Same as strcmp, whole blocks are only compared while there are at least 16 bytes left, the byte loop below handles the rest
+	while (numBytes >= STD_SIMD_SIZE && StdSimdIsLoadPageSafe(leftPntr) && StdSimdIsLoadPageSafe(rightPntr))
+	{
+		StdU8x16U_t leftVec = *(const StdU8x16U_t*)leftPntr;
+		StdU8x16U_t rightVec = *(const StdU8x16U_t*)rightPntr;
+		uint32_t stopMask = StdSimdMask((leftVec != rightVec) | (leftVec == 0));
+		if (stopMask != 0)
+		{
+			uint32_t stopIndex = __builtin_ctz(stopMask);
+			return (leftPntr[stopIndex] - rightPntr[stopIndex]);
+		}
+		leftPntr += STD_SIMD_SIZE;
+		rightPntr += STD_SIMD_SIZE;
+		numBytes -= STD_SIMD_SIZE;
+	}
+	#endif
 	if (!numBytes--) { return 0; }
 	for (; (*leftPntr && *rightPntr && numBytes && *leftPntr == *rightPntr); leftPntr++, rightPntr++, numBytes--);
 	return *leftPntr - *rightPntr;
 	#endif
 }
 
+// +--------------------------------------------------------------+
+// |                   Case-Insensitive Helpers                   |
+// +--------------------------------------------------------------+
+// Case folding works on a whole block at once: a byte is in the 26 letter range starting at rangeStart ('A' or 'a') if
+// (byte - rangeStart) < 26 as an unsigned compare, and flipping bit 0x20 of those bytes changes their case
+#define WORD64_CONTAINS_ZERO(word) (((word) - 0x0101010101010101ULL) & ~(word) & 0x8080808080808080ULL)
+
+// The SWAR version does the range compare on the low 7 bits of every byte with adds that can't carry into the next byte,
+// the top bit of each byte ends up set if it's >= rangeStart and (separately) if it's past the end of the range
+static inline uint64_t SwarChangeCase(uint64_t word, uint8_t rangeStart)
+{
+	uint64_t lowBits = (word & 0x7F7F7F7F7F7F7F7FULL);
+	uint64_t isPastRange = lowBits + (0x7F - (rangeStart + 25)) * 0x0101010101010101ULL;
+	uint64_t isInOrPastRange = lowBits + (0x80 - rangeStart) * 0x0101010101010101ULL;
+	uint64_t inRangeBits = ((isInOrPastRange ^ isPastRange) & ~word & 0x8080808080808080ULL);
+	return (word ^ (inRangeBits >> 2));
+}
+
+#if STD_SIMD_ENABLED
+#define CASE_BLOCK_SIZE STD_SIMD_SIZE
+static inline StdU8x16_t SimdChangeCase(StdU8x16_t block, uint8_t rangeStart)
+{
+	StdU8x16_t inRangeMask = (StdU8x16_t)((StdU8x16_t)(block - rangeStart) < 26);
+	return (block ^ (inRangeMask & 0x20));
+}
+#else
+#define CASE_BLOCK_SIZE 8
+#endif
+
+// A whole block (16 bytes with SIMD, 8 without) is only loaded if it doesn't cross into the next page
+static inline bool IsCaseBlockPageSafe(const unsigned char* pntr)
+{
+	return (((uintptr_t)pntr & (WASM_MEMORY_PAGE_SIZE-1)) <= (WASM_MEMORY_PAGE_SIZE - CASE_BLOCK_SIZE));
+}
+
+// Returns true if the block contains a byte where the strings stop comparing equal (ignoring case) or left's terminator
+static inline bool CaseBlockStops(const unsigned char* left, const unsigned char* right)
+{
+	#if STD_SIMD_ENABLED
+	StdU8x16_t leftVec = *(const StdU8x16U_t*)left;
+	StdU8x16_t rightVec = *(const StdU8x16U_t*)right;
+	return (StdSimdMask((SimdChangeCase(leftVec, 'A') != SimdChangeCase(rightVec, 'A')) | (leftVec == 0)) != 0);
+	#else
+	uint64_t leftWord = *(const a_u64_unaligned*)left;
+	uint64_t rightWord = *(const a_u64_unaligned*)right;
+	return (WORD64_CONTAINS_ZERO(leftWord) || SwarChangeCase(leftWord, 'A') != SwarChangeCase(rightWord, 'A'));
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                  Case-Insensitive Functions                  |
+// +--------------------------------------------------------------+
+// Whole blocks are skipped while they match, a block that doesn't (or that we can't load) is walked one byte at a time
+int strcasecmp(const char* left, const char* right)
+{
+	const unsigned char* leftPntr = (const unsigned char*)left;
+	const unsigned char* rightPntr = (const unsigned char*)right;
+	while (true)
+	{
+		if (IsCaseBlockPageSafe(leftPntr) && IsCaseBlockPageSafe(rightPntr) && !CaseBlockStops(leftPntr, rightPntr))
+		{
+			leftPntr += CASE_BLOCK_SIZE;
+			rightPntr += CASE_BLOCK_SIZE;
+			continue;
+		}
+		for (uint32_t bIndex = 0; bIndex < CASE_BLOCK_SIZE; bIndex++, leftPntr++, rightPntr++)
+		{
+			int leftLower = tolower(*leftPntr);
+			int rightLower = tolower(*rightPntr);
+			if (leftLower != rightLower || !leftLower) { return leftLower - rightLower; }
+		}
+	}
+}
+
+int strncasecmp(const char* left, const char* right, size_t numBytes)
+{
+	const unsigned char* leftPntr = (const unsigned char*)left;
+	const unsigned char* rightPntr = (const unsigned char*)right;
+	while (numBytes > 0)
+	{
+		if (numBytes >= CASE_BLOCK_SIZE && IsCaseBlockPageSafe(leftPntr) && IsCaseBlockPageSafe(rightPntr) && !CaseBlockStops(leftPntr, rightPntr))
+		{
+			leftPntr += CASE_BLOCK_SIZE;
+			rightPntr += CASE_BLOCK_SIZE;
+			numBytes -= CASE_BLOCK_SIZE;
+			continue;
+		}
+		for (uint32_t bIndex = 0; bIndex < CASE_BLOCK_SIZE && numBytes > 0; bIndex++, leftPntr++, rightPntr++, numBytes--)
+		{
+			int leftLower = tolower(*leftPntr);
+			int rightLower = tolower(*rightPntr);
+			if (leftLower != rightLower || !leftLower) { return leftLower - rightLower; }
+		}
+	}
+	return 0;
+}
+
+// Like __strchrnul but finds the first byte that matches targetChar in either case
+static const unsigned char* CaseChrNul(const unsigned char* str, uint8_t targetChar)
+{
+	if (!isalpha(targetChar)) { return (const unsigned char*)__strchrnul((const char*)str, targetChar); }
+	targetChar = (uint8_t)tolower(targetChar);
+	#if STD_SIMD_ENABLED
+	uint32_t misalignment = ((uintptr_t)str & (STD_SIMD_SIZE-1));
+	const StdU8x16_t* blockPntr = StdSimdAlignDown(str);
+	StdU8x16_t targetVec = StdSimdSplatU8(targetChar);
+	uint32_t stopMask = (StdSimdMask((*blockPntr == 0) | (SimdChangeCase(*blockPntr, 'A') == targetVec)) >> misalignment);
+	if (stopMask != 0) { return str + __builtin_ctz(stopMask); }
+	do
+	{
+		blockPntr++;
+		stopMask = StdSimdMask((*blockPntr == 0) | (SimdChangeCase(*blockPntr, 'A') == targetVec));
+	} while (stopMask == 0);
+	return (const unsigned char*)blockPntr + __builtin_ctz(stopMask);
+	#else
+	for (; ((uintptr_t)str & (sizeof(uint64_t)-1)) != 0; str++)
+	{
+		if (!*str || tolower(*str) == targetChar) { return str; }
+	}
+	const a_wide_u64* wordPntr = (const a_wide_u64*)str;
+	uint64_t targetMask = 0x0101010101010101ULL * targetChar;
+	for (; !WORD64_CONTAINS_ZERO(*wordPntr) && !WORD64_CONTAINS_ZERO(SwarChangeCase(*wordPntr, 'A') ^ targetMask); wordPntr++) { }
+	for (str = (const unsigned char*)wordPntr; *str && tolower(*str) != targetChar; str++) { }
+	return str;
+	#endif
+}
+
+#define strcasestr_BITOP(a,b,op) ((a)[(size_t)(b)/(8*sizeof *(a))] op (size_t)1<<((size_t)(b)%(8*sizeof *(a))))
+
+// Same as twoway_strstr (see string_strstr_helpers.c) but every byte of the needle and haystack goes through tolower first,
+// which is the same as running two-way on lowercased copies of both strings. needle must not be empty
+static char* twoway_strcasestr(const unsigned char* haystack, const unsigned char* needle)
+{
+	const unsigned char* charPntr;
+	size_t index, iVar, jVar, vVar, pVar, iVar0, pVar0, wVar, wVar0;
+	size_t byteset[32 / sizeof(size_t)] = { 0 };
+	size_t shiftBuffer[256];
+	
+	// Computing length of needle and fill shift table
+	for (index=0; needle[index] && haystack[index]; index++)
+	{
+		strcasestr_BITOP(byteset, tolower(needle[index]), |=);
+		shiftBuffer[tolower(needle[index])] = index + 1;
+	}
+	if (needle[index]) { return 0; } // hit the end of haystack
+	
+	// Compute maximal suffix
+	iVar = -1;
+	jVar = 0;
+	vVar = 1;
+	pVar = 1;
+	while (jVar + vVar < index)
+	{
+		int leftChar = tolower(needle[iVar + vVar]);
+		int rightChar = tolower(needle[jVar + vVar]);
+		if (leftChar == rightChar)
+		{
+			if (vVar == pVar)
+			{
+				jVar += pVar;
+				vVar = 1;
+			}
+			else { vVar++; }
+		}
+		else if (leftChar > rightChar)
+		{
+			jVar += vVar;
+			vVar = 1;
+			pVar = jVar - iVar;
+		}
+		else
+		{
+			iVar = jVar++;
+			vVar = pVar = 1;
+		}
+	}
+	iVar0 = iVar;
+	pVar0 = pVar;
+	
+	// And with the opposite comparison
+	iVar = -1;
+	jVar = 0;
+	vVar = 1;
+	pVar = 1;
+	while (jVar + vVar < index)
+	{
+		int leftChar = tolower(needle[iVar + vVar]);
+		int rightChar = tolower(needle[jVar + vVar]);
+		if (leftChar == rightChar)
+		{
+			if (vVar == pVar)
+			{
+				jVar += pVar;
+				vVar = 1;
+			}
+			else { vVar++; }
+		}
+		else if (leftChar < rightChar)
+		{
+			jVar += vVar;
+			vVar = 1;
+			pVar = jVar - iVar;
+		}
+		else
+		{
+			iVar = jVar++;
+			vVar = pVar = 1;
+		}
+	}
+	if (iVar + 1 > iVar0 + 1) { iVar0 = iVar; }
+	else { pVar = pVar0; }
+	
+	// Periodic needle?
+	if (strncasecmp((const char*)needle, (const char*)needle + pVar, iVar0 + 1))
+	{
+		wVar0 = 0;
+		pVar = MAX(iVar0, index - iVar0 - 1) + 1;
+	}
+	else { wVar0 = index - pVar; }
+	wVar = 0;
+	
+	// Initialize incremental end-of-haystack pointer
+	charPntr = haystack;
+	
+	// Search loop
+	for (;;)
+	{
+		// Update incremental end-of-haystack pointer
+		if ((charPntr - haystack) < index)
+		{
+			// Fast estimate for MAX(index,63)
+			size_t grow = (index | 63);
+			const unsigned char* newCharPntr = memchr(charPntr, 0, grow);
+			if (newCharPntr)
+			{
+				charPntr = newCharPntr;
+				if (charPntr - haystack < index) return 0;
+			}
+			else { charPntr += grow; }
+		}
+		
+		// Check last byte first; advance by shift on mismatch
+		int lastChar = tolower(haystack[index - 1]);
+		if (strcasestr_BITOP(byteset, lastChar, &))
+		{
+			vVar = index - shiftBuffer[lastChar];
+			if (vVar)
+			{
+				if (vVar < wVar) { vVar = wVar; }
+				haystack += vVar;
+				wVar = 0;
+				continue;
+			}
+		}
+		else
+		{
+			haystack += index;
+			wVar = 0;
+			continue;
+		}
+		
+		// Compare right half
+		for (vVar = MAX(iVar0 + 1, wVar); needle[vVar] && tolower(needle[vVar]) == tolower(haystack[vVar]); vVar++) { }
+		if (needle[vVar])
+		{
+			haystack += vVar - iVar0;
+			wVar = 0;
+			continue;
+		}
+		// Compare left half
+		for (vVar = iVar0 + 1; vVar > wVar && tolower(needle[vVar - 1]) == tolower(haystack[vVar - 1]); vVar--) { }
+		if (vVar <= wVar) { return (char*)haystack; }
+		haystack += pVar;
+		wVar = wVar0;
+	}
+}
+
+// Candidates are found by looking for the first character of the needle (in either case) a block at a time.
+// Like simd_memmem, if too many candidates fail (a needle like "aaaab" in a haystack of 'a's makes every position one)
+// we switch over to two-way. Each failed candidate is charged the full needleLen (the most strncasecmp could have looked at)
+// and the budget only grows with the haystack we've passed, so the work before switching is linear too
+char* strcasestr(const char* haystack, const char* needle)
+{
+	size_t needleLen = strlen(needle);
+	if (needleLen == 0) { return (char*)haystack; }
+	const unsigned char* candidatePntr = (const unsigned char*)haystack;
+	size_t numFailedBytes = 0;
+	while (true)
+	{
+		candidatePntr = CaseChrNul(candidatePntr, (uint8_t)needle[0]);
+		if (!*candidatePntr) { return 0; }
+		if (strncasecmp((const char*)candidatePntr, needle, needleLen) == 0) { return (char*)candidatePntr; }
+		candidatePntr++;
+		numFailedBytes += needleLen;
+		if (numFailedBytes > 1024 + (2 * (size_t)(candidatePntr - (const unsigned char*)haystack)))
+		{
+			return twoway_strcasestr(candidatePntr, (const unsigned char*)needle);
+		}
+	}
+}
+
+static inline void ChangeCaseInPlace(unsigned char* bytePntr, size_t numBytes, uint8_t rangeStart)
+{
+	#if STD_SIMD_ENABLED
+	for (; numBytes >= STD_SIMD_SIZE; numBytes -= STD_SIMD_SIZE, bytePntr += STD_SIMD_SIZE)
+	{
+		*(StdU8x16U_t*)bytePntr = SimdChangeCase(*(const StdU8x16U_t*)bytePntr, rangeStart);
+	}
+	#endif
+	for (; numBytes >= sizeof(uint64_t); numBytes -= sizeof(uint64_t), bytePntr += sizeof(uint64_t))
+	{
+		*(a_u64_unaligned*)bytePntr = SwarChangeCase(*(const a_u64_unaligned*)bytePntr, rangeStart);
+	}
+	for (; numBytes > 0; numBytes--, bytePntr++)
+	{
+		if ((uint8_t)(*bytePntr - rangeStart) < 26) { *bytePntr ^= 0x20; }
+	}
+}
+
+// Converts the ASCII letters in the first numBytes of str, any other bytes (including UTF-8 sequences) are left alone
+void StdStrToLowerInPlace(char* str, size_t numBytes)
+{
+	ChangeCaseInPlace((unsigned char*)str, numBytes, 'A');
+}
+void StdStrToUpperInPlace(char* str, size_t numBytes)
+{
+	ChangeCaseInPlace((unsigned char*)str, numBytes, 'a');
+}
+
 size_t strlen(const char* str)
 {
 	#if PIG_WASM_STD_USE_BUILTIN_STRLEN
 	return __builtin_strlen(str);
+	#elif STD_SIMD_ENABLED
+	// The first block is rounded down to a 16-byte boundary and the lanes before str are shifted out of the mask.
+	// Every load is aligned so we never touch a 16-byte block (and so never a page) that doesn't contain part of the string
+	uint32_t misalignment = ((uintptr_t)str & (STD_SIMD_SIZE-1));
+	const StdU8x16_t* blockPntr = StdSimdAlignDown(str);
+	uint32_t zeroMask = (StdSimdMask(*blockPntr == 0) >> misalignment);
+	if (zeroMask != 0) { return __builtin_ctz(zeroMask); }
+	do { blockPntr++; zeroMask = StdSimdMask(*blockPntr == 0); } while (zeroMask == 0);
+	return ((const char*)blockPntr - str) + __builtin_ctz(zeroMask);
 	#else
 	const char* startPntr = str;
 	const a_size_t* wordPntr;
@@ -437,9 +1163,121 @@ size_t wcslen(const wchar_t* str)
 {
 	#if PIG_WASM_STD_USE_BUILTIN_WCSLEN
 	return __builtin_wcslen(str);
+	#elif STD_SIMD_ENABLED
+	// Same as strlen but each lane is a 4 byte wchar_t (i32x4.eq), so a terminator sets 4 bits in the mask
+	uint32_t misalignment = ((uintptr_t)str & (STD_SIMD_SIZE-1));
+	const StdI32x4_t* blockPntr = (const StdI32x4_t*)StdSimdAlignDown(str);
+	uint32_t zeroMask = (StdSimdMask((StdI8x16_t)(*blockPntr == 0)) >> misalignment);
+	if (zeroMask != 0) { return __builtin_ctz(zeroMask) / sizeof(wchar_t); }
+	do { blockPntr++; zeroMask = StdSimdMask((StdI8x16_t)(*blockPntr == 0)); } while (zeroMask == 0);
+	return (((const char*)blockPntr - (const char*)str) + __builtin_ctz(zeroMask)) / sizeof(wchar_t);
 	#else
-	const wchar_t* startPntr;
-	for (startPntr = str; *str; str++);
+	// Checks two characters at a time using 8-byte aligned words
+	const wchar_t* startPntr = str;
+	if (((uintptr_t)str & sizeof(wchar_t)) != 0)
+	{
+		if (!*str) { return 0; }
+		str++;
+	}
+	const a_wide_u64* wordPntr;
+	for (wordPntr = (const a_wide_u64*)str; !WIDE_WORD_CONTAINS_ZERO(*wordPntr); wordPntr++) { }
+	str = (const wchar_t*)wordPntr;
+	if (*str) { str++; }
 	return (str - startPntr);
 	#endif
+}
+
+wchar_t* wcschr(const wchar_t* str, wchar_t targetChar)
+{
+	if (!targetChar) { return (wchar_t*)str + wcslen(str); }
+	#if STD_SIMD_ENABLED
+	uint32_t misalignment = ((uintptr_t)str & (STD_SIMD_SIZE-1));
+	const StdI32x4_t* blockPntr = (const StdI32x4_t*)StdSimdAlignDown(str);
+	StdI32x4_t targetVec = StdSimdSplatI32((int32_t)targetChar);
+	uint32_t stopMask = (StdSimdMask((StdI8x16_t)((*blockPntr == 0) | (*blockPntr == targetVec))) >> misalignment);
+	if (stopMask != 0) { str = (const wchar_t*)((const char*)str + __builtin_ctz(stopMask)); }
+	else
+	{
+		do
+		{
+			blockPntr++;
+			stopMask = StdSimdMask((StdI8x16_t)((*blockPntr == 0) | (*blockPntr == targetVec)));
+		} while (stopMask == 0);
+		str = (const wchar_t*)((const char*)blockPntr + __builtin_ctz(stopMask));
+	}
+	#else
+	if (((uintptr_t)str & sizeof(wchar_t)) != 0 && *str && *str != targetChar) { str++; }
+	if (*str && *str != targetChar)
+	{
+		const a_wide_u64* wordPntr;
+		uint64_t targetMask = (uint64_t)(uint32_t)targetChar * 0x0000000100000001ULL;
+		for (wordPntr = (const a_wide_u64*)str; !WIDE_WORD_CONTAINS_ZERO(*wordPntr) && !WIDE_WORD_CONTAINS_ZERO(*wordPntr ^ targetMask); wordPntr++) { }
+		str = (const wchar_t*)wordPntr;
+		if (*str && *str != targetChar) { str++; }
+	}
+	#endif
+	return ((*str == targetChar) ? (wchar_t*)str : 0);
+}
+
+int wcscmp(const wchar_t* left, const wchar_t* right)
+{
+	#if STD_SIMD_ENABLED
+	// Same as strcmp, 4 characters at a time with a one character at a time fallback for blocks that would cross into the next page.
+	// Both loops stop with left and right pointing at the first pair that differs (or at the terminator) and the comparison below does the rest
+	while (true)
+	{
+		if (StdSimdIsLoadPageSafe(left) && StdSimdIsLoadPageSafe(right))
+		{
+			StdI32x4U_t leftVec = *(const StdI32x4U_t*)left;
+			StdI32x4U_t rightVec = *(const StdI32x4U_t*)right;
+			uint32_t stopMask = StdSimdMask((StdI8x16_t)((leftVec != rightVec) | (leftVec == 0)));
+			if (stopMask != 0)
+			{
+				uint32_t stopIndex = __builtin_ctz(stopMask) / sizeof(wchar_t);
+				left += stopIndex;
+				right += stopIndex;
+				break;
+			}
+			left += STD_SIMD_SIZE / sizeof(wchar_t);
+			right += STD_SIMD_SIZE / sizeof(wchar_t);
+		}
+		else
+		{
+			uint32_t cIndex = 0;
+			for (; cIndex < STD_SIMD_SIZE / sizeof(wchar_t) && *left == *right && *left; cIndex++, left++, right++) { }
+			if (cIndex < STD_SIMD_SIZE / sizeof(wchar_t)) { break; }
+		}
+	}
+	#endif
+	for (; *left == *right && *left; left++, right++) { }
+	return ((*left < *right) ? -1 : (*left > *right));
+}
+
+// memcpy already uses memory.copy (or the inline path for small sizes) so there's nothing to gain from copying 4 characters at a time ourselves
+wchar_t* wmemcpy(wchar_t* dest, const wchar_t* source, size_t numChars)
+{
+	return (wchar_t*)memcpy(dest, source, numChars * sizeof(wchar_t));
+}
+
+wchar_t* wmemset(wchar_t* dest, wchar_t value, size_t numChars)
+{
+	wchar_t* destPntr = dest;
+	// Values like 0 and -1 are the same byte repeated so memset (and memory.fill) can do it
+	if (numChars > 16 && (uint32_t)value == ((uint32_t)value & 0xFF) * 0x01010101U) { return (wchar_t*)memset(dest, value & 0xFF, numChars * sizeof(wchar_t)); }
+	#if STD_SIMD_ENABLED
+	if (numChars >= STD_SIMD_SIZE / sizeof(wchar_t))
+	{
+		// The last store is moved back to end exactly at numChars, overlapping the one before it
+		StdI32x4_t valueVec = StdSimdSplatI32((int32_t)value);
+		wchar_t* lastBlockPntr = dest + numChars - (STD_SIMD_SIZE / sizeof(wchar_t));
+		for (; destPntr < lastBlockPntr; destPntr += STD_SIMD_SIZE / sizeof(wchar_t)) { *(StdI32x4U_t*)destPntr = valueVec; }
+		*(StdI32x4U_t*)lastBlockPntr = valueVec;
+		return dest;
+	}
+	#else
+	uint64_t value64 = (uint64_t)(uint32_t)value * 0x0000000100000001ULL;
+	for (; numChars >= 2; numChars -= 2, destPntr += 2) { *(a_u64_unaligned*)destPntr = value64; }
+	#endif
+	for (; numChars > 0; numChars--, destPntr++) { *destPntr = value; }
+	return dest;
 }
\ No newline at end of file
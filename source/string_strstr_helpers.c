@@ -10,6 +10,28 @@ void* memchr(const void* pntr, int targetChar, size_t numBytes)
 {
 	const unsigned char* charPntr = pntr;
 	targetChar = (unsigned char)targetChar;
+	#if STD_SIMD_ENABLED
+	if (numBytes == 0) { return 0; }
+	// Same aligned block walk as strlen, we only move on to the next block if there are bytes left to check in it
+	uint32_t numBlockBytes = STD_SIMD_SIZE - ((uintptr_t)charPntr & (STD_SIMD_SIZE-1));
+	const StdU8x16_t* blockPntr = StdSimdAlignDown(charPntr);
+	StdU8x16_t targetVec = StdSimdSplatU8((uint8_t)targetChar);
+	uint32_t matchMask = (StdSimdMask(*blockPntr == targetVec) >> (STD_SIMD_SIZE - numBlockBytes));
+	while (true)
+	{
+		if (matchMask != 0)
+		{
+			uint32_t matchIndex = __builtin_ctz(matchMask);
+			return ((matchIndex < numBytes) ? (void*)(charPntr + matchIndex) : 0);
+		}
+		if (numBytes <= numBlockBytes) { return 0; }
+		charPntr += numBlockBytes;
+		numBytes -= numBlockBytes;
+		numBlockBytes = STD_SIMD_SIZE;
+		blockPntr++;
+		matchMask = StdSimdMask(*blockPntr == targetVec);
+	}
+	#else
 	for (; ((uintptr_t)charPntr & (sizeof(size_t)-1)) && numBytes && *charPntr != targetChar; charPntr++, numBytes--) { }
 	if (numBytes && *charPntr != targetChar)
 	{
@@ -20,6 +42,7 @@ void* memchr(const void* pntr, int targetChar, size_t numBytes)
 	}
 	for (; numBytes && *charPntr != targetChar; charPntr++, numBytes--) { }
 	return (numBytes ? (void*)charPntr : 0);
+	#endif
 }
 
 char* twobyte_strstr(const unsigned char* haystack, const unsigned char* needle)
@@ -189,11 +212,243 @@ char* twoway_strstr(const unsigned char* haystack, const unsigned char* needle)
 	}
 }
 
+// Same as twoway_strstr but the haystack length is known up front (haystackEnd) and the needle isn't null-terminated
+char* twoway_memmem(const unsigned char* haystack, const unsigned char* haystackEnd, const unsigned char* needle, size_t needleLen)
+{
+	size_t index, iVar, jVar, vVar, pVar, iVar0, pVar0, wVar, wVar0;
+	size_t byteset[32 / sizeof(size_t)] = { 0 };
+	size_t shiftBuffer[256];
+	
+	// Fill shift table
+	for (index = 0; index < needleLen; index++)
+	{
+		strstr_BITOP(byteset, needle[index], |=);
+		shiftBuffer[needle[index]] = index + 1;
+	}
+	
+	// Compute maximal suffix
+	iVar = -1;
+	jVar = 0;
+	vVar = 1;
+	pVar = 1;
+	while (jVar + vVar < needleLen)
+	{
+		if (needle[iVar + vVar] == needle[jVar + vVar])
+		{
+			if (vVar == pVar)
+			{
+				jVar += pVar;
+				vVar = 1;
+			}
+			else { vVar++; }
+		}
+		else if (needle[iVar + vVar] > needle[jVar + vVar])
+		{
+			jVar += vVar;
+			vVar = 1;
+			pVar = jVar - iVar;
+		}
+		else
+		{
+			iVar = jVar++;
+			vVar = pVar = 1;
+		}
+	}
+	iVar0 = iVar;
+	pVar0 = pVar;
+	
+	// And with the opposite comparison
+	iVar = -1;
+	jVar = 0;
+	vVar = 1;
+	pVar = 1;
+	while (jVar + vVar < needleLen)
+	{
+		if (needle[iVar + vVar] == needle[jVar + vVar])
+		{
+			if (vVar == pVar)
+			{
+				jVar += pVar;
+				vVar = 1;
+			}
+			else { vVar++; }
+		}
+		else if (needle[iVar + vVar] < needle[jVar + vVar])
+		{
+			jVar += vVar;
+			vVar = 1;
+			pVar = jVar - iVar;
+		}
+		else
+		{
+			iVar = jVar++;
+			vVar = pVar = 1;
+		}
+	}
+	if (iVar + 1 > iVar0 + 1) { iVar0 = iVar; }
+	else { pVar = pVar0; }
+	
+	// Periodic needle?
+	if (memcmp(needle, needle + pVar, iVar0 + 1))
+	{
+		wVar0 = 0;
+		pVar = MAX(iVar0, needleLen - iVar0 - 1) + 1;
+	}
+	else { wVar0 = needleLen - pVar; }
+	wVar = 0;
+	
+	// Search loop
+	for (;;)
+	{
+		// If remainder of haystack is shorter than needle, we're done
+		if ((size_t)(haystackEnd - haystack) < needleLen) { return 0; }
+		
+		// Check last byte first; advance by shift on mismatch
+		if (strstr_BITOP(byteset, haystack[needleLen - 1], &))
+		{
+			vVar = needleLen - shiftBuffer[haystack[needleLen - 1]];
+			if (vVar)
+			{
+				if (vVar < wVar) { vVar = wVar; }
+				haystack += vVar;
+				wVar = 0;
+				continue;
+			}
+		}
+		else
+		{
+			haystack += needleLen;
+			wVar = 0;
+			continue;
+		}
+		
+		// Compare right half
+		for (vVar = MAX(iVar0 + 1, wVar); vVar < needleLen && needle[vVar] == haystack[vVar]; vVar++) { }
+		if (vVar < needleLen)
+		{
+			haystack += vVar - iVar0;
+			wVar = 0;
+			continue;
+		}
+		// Compare left half
+		for (vVar = iVar0 + 1; vVar > wVar && needle[vVar - 1] == haystack[vVar - 1]; vVar--) { }
+		if (vVar <= wVar) { return (char*)haystack; }
+		haystack += pVar;
+		wVar = wVar0;
+	}
+}
+
+#if STD_SIMD_ENABLED
+// Failed candidates are charged needleLen bytes each (the most the memcmp could have looked at) and we give up on the filter once
+// that passes SIMD_STRSTR_BUDGET_BASE plus twice the distance searched so far, which keeps the work before two-way takes over linear
+#define SIMD_STRSTR_BUDGET_BASE 1024
+
+// "SIMD-friendly" substring search: for 16 starting positions at once, compare the byte at each position against the
+// first byte of the needle and the byte needleLen-1 later against the last byte of the needle. Only positions where
+// both match get a full memcmp. That filter is very effective on normal text, but with a needle like "aaaab" in a haystack of 'a's
+// every position is a candidate, so if too many candidates fail we stop and the caller switches over to two-way for its linear worst case.
+// Returns the match, or nullptr with *stopPntrOut set to where two-way should pick up (or nullptr if there's no match at all).
+// numFailedBytes and distanceBefore (how much haystack came before this call) let simd_strstr carry the budget across chunks.
+// needleLen must be at least 2 and no more than haystackLen
+static char* simd_memmem_budgeted(const unsigned char* haystack, size_t haystackLen, const unsigned char* needle, size_t needleLen,
+	size_t* numFailedBytes, size_t distanceBefore, const unsigned char** stopPntrOut)
+{
+	StdU8x16_t firstVec = StdSimdSplatU8(needle[0]);
+	StdU8x16_t lastVec = StdSimdSplatU8(needle[needleLen-1]);
+	size_t numPositions = haystackLen - needleLen + 1;
+	size_t position = 0;
+	*stopPntrOut = 0;
+	
+	// Neither load can go past the end of the haystack as long as there are 16 positions left to check
+	while (position + STD_SIMD_SIZE <= numPositions)
+	{
+		StdU8x16U_t firstBlock = *(const StdU8x16U_t*)(haystack + position);
+		StdU8x16U_t lastBlock = *(const StdU8x16U_t*)(haystack + position + needleLen - 1);
+		uint32_t candidateMask = StdSimdMask((firstBlock == firstVec) & (lastBlock == lastVec));
+		while (candidateMask != 0)
+		{
+			const unsigned char* candidate = haystack + position + __builtin_ctz(candidateMask);
+			if (memcmp(candidate + 1, needle + 1, needleLen - 2) == 0) { return (char*)candidate; }
+			*numFailedBytes += needleLen;
+			candidateMask &= (candidateMask - 1);
+		}
+		position += STD_SIMD_SIZE;
+		if (*numFailedBytes > SIMD_STRSTR_BUDGET_BASE + (2 * (distanceBefore + position)))
+		{
+			*stopPntrOut = haystack + position;
+			return 0;
+		}
+	}
+	
+	// Less than 16 positions left so at most 15 more candidates, not worth counting
+	for (; position < numPositions; position++)
+	{
+		const unsigned char* candidate = haystack + position;
+		if (candidate[0] == needle[0] && candidate[needleLen-1] == needle[needleLen-1] && memcmp(candidate + 1, needle + 1, needleLen - 2) == 0)
+		{
+			return (char*)candidate;
+		}
+	}
+	return 0;
+}
+
+// needleLen must be at least 2 and no more than haystackLen
+char* simd_memmem(const unsigned char* haystack, size_t haystackLen, const unsigned char* needle, size_t needleLen)
+{
+	size_t numFailedBytes = 0;
+	const unsigned char* stopPntr = 0;
+	char* result = simd_memmem_budgeted(haystack, haystackLen, needle, needleLen, &numFailedBytes, 0, &stopPntr);
+	if (stopPntr) { return twoway_memmem(stopPntr, haystack + haystackLen, needle, needleLen); }
+	return result;
+}
+
+// How far past the part of the haystack we know about we look for the null-terminator each time simd_strstr needs more haystack
+#define SIMD_STRSTR_CHUNK_SIZE 4096
+
+// We don't know the length of the haystack up front, so we find it a chunk at a time (with memchr, which is also vectorized)
+// and search each chunk with simd_memmem_budgeted. Chunks overlap by needleLen-1 bytes so a match that straddles two chunks is
+// still found. The failed candidate budget carries over between chunks and once it runs out two-way searches the rest of the string
+char* simd_strstr(const unsigned char* haystack, const unsigned char* needle, size_t needleLen)
+{
+	const unsigned char* chunkStart = haystack;
+	const unsigned char* scanPntr = haystack;
+	size_t numFailedBytes = 0;
+	for (;;)
+	{
+		const unsigned char* terminator = memchr(scanPntr, 0, needleLen + SIMD_STRSTR_CHUNK_SIZE);
+		const unsigned char* chunkEnd = (terminator ? terminator : scanPntr + needleLen + SIMD_STRSTR_CHUNK_SIZE);
+		if ((size_t)(chunkEnd - chunkStart) >= needleLen)
+		{
+			const unsigned char* stopPntr = 0;
+			char* result = simd_memmem_budgeted(chunkStart, chunkEnd - chunkStart, needle, needleLen, &numFailedBytes, (size_t)(chunkStart - haystack), &stopPntr);
+			if (result) { return result; }
+			if (stopPntr) { return twoway_strstr(stopPntr, needle); }
+		}
+		if (terminator) { return 0; }
+		chunkStart = chunkEnd - (needleLen - 1);
+		scanPntr = chunkEnd;
+	}
+}
+#endif //STD_SIMD_ENABLED
+
 char* __strchrnul(const char* str, int targetChar)
 {
 	targetChar = (unsigned char)targetChar;
 	if (!targetChar) { return (char*)str + strlen(str); }
 	
+	#if STD_SIMD_ENABLED
+	uint32_t misalignment = ((uintptr_t)str & (STD_SIMD_SIZE-1));
+	const StdU8x16_t* blockPntr = StdSimdAlignDown(str);
+	StdU8x16_t targetVec = StdSimdSplatU8((uint8_t)targetChar);
+	uint32_t stopMask = (StdSimdMask((*blockPntr == 0) | (*blockPntr == targetVec)) >> misalignment);
+	if (stopMask != 0) { return (char*)str + __builtin_ctz(stopMask); }
+	do
+	{
+		blockPntr++;
+		stopMask = StdSimdMask((*blockPntr == 0) | (*blockPntr == targetVec));
+	} while (stopMask == 0);
+	return (char*)blockPntr + __builtin_ctz(stopMask);
+	#else
 	const a_size_t* wordPntr;
 	for (; (uintptr_t)str % sizeof(size_t); str++)
 	{
@@ -207,6 +462,7 @@ char* __strchrnul(const char* str, int targetChar)
 	for (; *str && *(unsigned char*)str != targetChar; str++) { }
 	
 	return (char*)str;
+	#endif
 }
 
 char *strchr(const char* str, int targetChar)
@@ -0,0 +1,122 @@
+/*
+File:   benchmarks.cpp
+Author: Taylor Robbins
+Date:   10\17\2026
+Description:
+	** Holds some timing loops that we use to tune the thresholds in the library. These aren't run
+	** by default (see RUN_BENCHMARKS in main.cpp) and the results are printed to the console
+*/
+
+#define BENCHMARK_NUM_ITERATIONS 200000
+
+// Keeps the compiler from removing benchmark loops whose results are never used
+volatile uint32_t benchmarkSink = 0;
+
+// Compares memcpy/memset (which do sizes up to PIG_WASM_STD_MEMCPY_INLINE_MAX/PIG_WASM_STD_MEMSET_INLINE_MAX inline)
+// against calling memory.copy/memory.fill directly for every size up to 64. The threshold should sit where the
+// "bulk" column starts winning. numBytes is read from a volatile so clang can't specialize the builtins for a known size
+void RunMemoryBenchmarks()
+{
+	static uint8_t sourceBuffer[256];
+	static uint8_t destBuffer[256];
+	for (uint32_t bIndex = 0; bIndex < sizeof(sourceBuffer); bIndex++) { sourceBuffer[bIndex] = (uint8_t)bIndex; }
+	
+	for (uint32_t size = 1; size <= 64; size++)
+	{
+		volatile uint32_t volatileSize = size;
+		uint32_t numBytes = volatileSize;
+		
+		double startTime = jsGetTime();
+		for (uint32_t iIndex = 0; iIndex < BENCHMARK_NUM_ITERATIONS; iIndex++) { memcpy(&destBuffer[iIndex & 63], &sourceBuffer[iIndex & 127], numBytes); }
+		double inlineCopyTime = jsGetTime() - startTime;
+		startTime = jsGetTime();
+		for (uint32_t iIndex = 0; iIndex < BENCHMARK_NUM_ITERATIONS; iIndex++) { __builtin_memcpy(&destBuffer[iIndex & 63], &sourceBuffer[iIndex & 127], numBytes); }
+		double bulkCopyTime = jsGetTime() - startTime;
+		
+		startTime = jsGetTime();
+		for (uint32_t iIndex = 0; iIndex < BENCHMARK_NUM_ITERATIONS; iIndex++) { memset(&destBuffer[iIndex & 63], (int)iIndex, numBytes); }
+		double inlineSetTime = jsGetTime() - startTime;
+		startTime = jsGetTime();
+		for (uint32_t iIndex = 0; iIndex < BENCHMARK_NUM_ITERATIONS; iIndex++) { __builtin_memset(&destBuffer[iIndex & 63], (int)iIndex, numBytes); }
+		double bulkSetTime = jsGetTime() - startTime;
+		benchmarkSink += destBuffer[size];
+		
+		jsPrintInteger("Benchmark Size", (int)size);
+		jsPrintFloat("  memcpy (ns)", (inlineCopyTime * 1000000.0) / BENCHMARK_NUM_ITERATIONS);
+		jsPrintFloat("  memory.copy (ns)", (bulkCopyTime * 1000000.0) / BENCHMARK_NUM_ITERATIONS);
+		jsPrintFloat("  memset (ns)", (inlineSetTime * 1000000.0) / BENCHMARK_NUM_ITERATIONS);
+		jsPrintFloat("  memory.fill (ns)", (bulkSetTime * 1000000.0) / BENCHMARK_NUM_ITERATIONS);
+	}
+}
+
+// What most projects were using before StdHash64, here for comparison
+uint64_t BenchmarkFnv1a64(const void* dataPntr, size_t numBytes)
+{
+	const uint8_t* bytePntr = (const uint8_t*)dataPntr;
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (size_t bIndex = 0; bIndex < numBytes; bIndex++) { hash = (hash ^ bytePntr[bIndex]) * 0x100000001B3ULL; }
+	return hash;
+}
+
+// Prints the throughput (MB/s) of StdHash64 and a plain FNV-1a loop for short keys and for long buffers. Every call hashes
+// exactly size bytes, the start offset rotates through 0-7 so unaligned reads are measured too
+void RunHashBenchmarks()
+{
+	const uint32_t bufferSize = (64*1024) + 8;
+	uint8_t* buffer = (uint8_t*)malloc(bufferSize);
+	for (uint32_t bIndex = 0; bIndex < bufferSize; bIndex++) { buffer[bIndex] = (uint8_t)(bIndex * 31); }
+	
+	const uint32_t sizes[] = { 8, 16, 32, 64, 256, 4096, 64*1024 };
+	for (uint32_t sIndex = 0; sIndex < sizeof(sizes)/sizeof(sizes[0]); sIndex++)
+	{
+		uint32_t size = sizes[sIndex];
+		uint32_t numIterations = (256*1024*1024) / (size * 64); //about 4MB hashed for every size
+		uint64_t hashSum = 0;
+		
+		double startTime = jsGetTime();
+		for (uint32_t iIndex = 0; iIndex < numIterations; iIndex++) { hashSum += StdHash64(&buffer[iIndex & 7], size, iIndex); }
+		double stdHashTime = jsGetTime() - startTime;
+		startTime = jsGetTime();
+		for (uint32_t iIndex = 0; iIndex < numIterations; iIndex++) { hashSum += BenchmarkFnv1a64(&buffer[iIndex & 7], size); }
+		double fnvTime = jsGetTime() - startTime;
+		benchmarkSink += (uint32_t)hashSum;
+		
+		double numMegabytes = ((double)size * numIterations) / (1024.0 * 1024.0);
+		jsPrintInteger("Hash Benchmark Size", (int)size);
+		jsPrintFloat("  StdHash64 (MB/s)", numMegabytes / (stdHashTime / 1000.0));
+		jsPrintFloat("  FNV-1a (MB/s)", numMegabytes / (fnvTime / 1000.0));
+	}
+	free(buffer);
+}
+
+int BenchmarkCompareKey(const void* left, const void* right)
+{
+	uint32_t leftKey = *(const uint32_t*)left;
+	uint32_t rightKey = *(const uint32_t*)right;
+	return ((leftKey > rightKey) - (leftKey < rightKey));
+}
+
+// Prints how long qsort takes on 100k random items for the item sizes that have their own swap path (4, 8, 16, multiples
+// of 4/8/16) and a couple that don't. Every item starts with a u32 key so the comparison cost is the same for all of them
+void RunQsortBenchmarks()
+{
+	const uint32_t numItems = 100000;
+	const uint32_t itemSizes[] = { 4, 8, 12, 16, 24, 32, 5, 7 };
+	const uint32_t maxItemSize = 32;
+	uint8_t* items = (uint8_t*)malloc(numItems * maxItemSize);
+	for (uint32_t sIndex = 0; sIndex < sizeof(itemSizes)/sizeof(itemSizes[0]); sIndex++)
+	{
+		uint32_t itemSize = itemSizes[sIndex];
+		uint32_t randomState = 12345;
+		for (uint32_t iIndex = 0; iIndex < numItems * itemSize; iIndex++) { randomState = (randomState * 1103515245) + 12345; items[iIndex] = (uint8_t)(randomState >> 16); }
+		
+		double startTime = jsGetTime();
+		qsort(items, numItems, itemSize, BenchmarkCompareKey);
+		double sortTime = jsGetTime() - startTime;
+		benchmarkSink += items[0];
+		
+		jsPrintInteger("Qsort Benchmark Item Size", (int)itemSize);
+		jsPrintFloat("  qsort 100k items (ms)", sortTime);
+	}
+	free(items);
+}
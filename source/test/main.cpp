@@ -14,10 +14,16 @@ Description:
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <ctype.h>
 #include <stdbool.h>
 #include <stdarg.h>
 #include <intrin.h>
 #include <stdio.h>
+#include <std_arena.h>
+#include <std_hash.h>
+#include <std_utf.h>
+#include <new>
 #else
 #include "gylib/gy_defines_check.h"
 #define GYLIB_LOOKUP_PRIMES_10
@@ -27,8 +33,12 @@ Description:
 WASM_IMPORTED_FUNC void jsPrintInteger(const char* labelStrPntr, int number);
 WASM_IMPORTED_FUNC void jsPrintFloat(const char* labelStrPntr, double number);
 WASM_IMPORTED_FUNC void jsPrintString(const char* labelStrPntr, const char* strPntr);
+WASM_IMPORTED_FUNC double jsGetTime(); //milliseconds, from performance.now()
+
+#define RUN_BENCHMARKS 0
 
 #include "test_cases.cpp"
+#include "benchmarks.cpp"
 
 // +==============================+
 // |          Initialize          |
@@ -38,5 +48,15 @@ WASM_EXPORTED_FUNC(void, Initialize)
 	RunMathTestCases();
 	RunStringTestCases();
 	RunStdLibTestCases();
+	RunHeapTestCases();
+	RunArenaTestCases();
+	RunHashTestCases();
+	RunUtfTestCases();
 	RunStdioTestCases();
+	
+	#if RUN_BENCHMARKS
+	RunMemoryBenchmarks();
+	RunHashBenchmarks();
+	RunQsortBenchmarks();
+	#endif
 }
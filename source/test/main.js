@@ -26,10 +26,16 @@ function jsPrintString(labelStrPntr, strPntr)
 	console.log(labelStr + ": " + str);
 }
 
+function jsGetTime()
+{
+	return performance.now();
+}
+
 appApiFuncs = {
 	jsPrintInteger: jsPrintInteger,
 	jsPrintFloat: jsPrintFloat,
 	jsPrintString: jsPrintString,
+	jsGetTime: jsGetTime,
 };
 
 async function MainLoop()
@@ -87,6 +93,7 @@ async function MainLoop()
 	
 	// function renderFrame()
 	// {
+	// 	wasmModule.exports.StdBeginFrame();
 	// 	wasmModule.exports.UpdateAndRender(16.6666);
 	// 	window.requestAnimationFrame(renderFrame);
 	// }
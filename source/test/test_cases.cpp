@@ -576,13 +576,30 @@ void RunStringTestCases()
 	memmove(&testArray[0], &testArray[8], 4);
 	// for (int bIndex = 0; bIndex < sizeof(testArray); bIndex++) { jsPrintInteger("", testArray[bIndex]); }
 	
-	//TODO: Add test cases for memset
-	
-	//TODO: Add test cases for memcpy
+	// Every size up to 64 goes through the inline path, check the bytes right around the end of each fill/copy aren't touched
+	bool smallFillsCorrect = true;
+	bool smallCopiesCorrect = true;
+	for (uint32_t size = 0; size <= 70; size++)
+	{
+		memset(&testArray2[0], 0x11, sizeof(testArray2));
+		memset(&testArray2[3], 0x22, size);
+		for (uint32_t bIndex = 0; bIndex < sizeof(testArray2); bIndex++)
+		{
+			if (testArray2[bIndex] != ((bIndex >= 3 && bIndex < 3 + size) ? 0x22 : 0x11)) { smallFillsCorrect = false; }
+		}
+		memcpy(&testArray2[5], &testArray[1], size);
+		for (uint32_t bIndex = 0; bIndex < size; bIndex++) { if (testArray2[5 + bIndex] != testArray[1 + bIndex]) { smallCopiesCorrect = false; } }
+		if (testArray2[5 + size] != 0x11) { smallCopiesCorrect = false; } //the fill ends 2 bytes before the copy does
+	}
+	TestCaseInt(smallFillsCorrect, true);
+	TestCaseInt(smallCopiesCorrect, true);
 	
 	TestCaseInt(memcmp(&testArray[0], &testArray[0], 5), 0);
 	TestCaseInt(memcmp(&testArray[0], &testArray[5], 5), 33);
 	TestCaseInt(memcmp(&testArray[5], &testArray[0], 5), -33);
+	TestCaseInt(memcmp(&testArray[10], &testArray[11], 100), 0);
+	TestCaseInt(memcmp(&testArray[20], &testArray[21], 107), 'b'); //only the very last byte differs
+	TestCaseInt(memcmp(&testArray[21], &testArray[20], 107), -'b');
 	
 	//TODO: Add test cases for memmove
 	
@@ -609,6 +626,19 @@ void RunStringTestCases()
 	jsPrintInteger("substr5", (int)(substr5 - (char*)&testArray[0]));
 	char* substr6 = strstr((char*)&testArray[0], "AAbbAAAAAAbb");
 	jsPrintInteger("substr6", (int)(substr6 - (char*)&testArray[0]));
+	TestCaseInt((int)(strstr((char*)&testArray[0], "AAbbAAAAAAbb") - (char*)&testArray[0]), 0);
+	TestCaseInt((int)(strstr((char*)&testArray[0], "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb") - (char*)&testArray[0]), 10);
+	TestCaseInt((strstr((char*)&testArray[0], "bbbbA") == nullptr), true);
+	TestCaseInt((int)((char*)memmem(&testArray[0], 127, "bA", 2) - (char*)&testArray[0]), 3);
+	TestCaseInt((memmem(&testArray[0], 4, "bA", 2) == nullptr), true);
+	// Every position passes the first/last byte filter and then fails the full compare, so these go through the two-way fallback
+	static char repeatStr[2001];
+	memset(repeatStr, 'a', 2000);
+	repeatStr[1990] = 'b';
+	const char* repeatNeedle = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaba";
+	TestCaseInt((int)(strstr(repeatStr, repeatNeedle) - repeatStr), 1960);
+	TestCaseInt((int)((char*)memmem(repeatStr, 2000, repeatNeedle, 32) - repeatStr), 1960);
+	TestCaseInt((memmem(repeatStr, 1990, repeatNeedle, 32) == nullptr), true);
 	
 	TestCaseInt(strcmp((char*)&testArray[0], (char*)&testArray[0]), 0);
 	TestCaseInt(strcmp((char*)&testArray[0], (char*)&testArray[1]), -33);
@@ -617,10 +647,84 @@ void RunStringTestCases()
 	TestCaseInt(strncmp((char*)&testArray[0], (char*)&testArray[0], 5), 0);
 	TestCaseInt(strncmp((char*)&testArray[0], (char*)&testArray[5], 5), 33);
 	TestCaseInt(strncmp((char*)&testArray[5], (char*)&testArray[0], 5), -33);
+	TestCaseInt(strcmp((char*)&testArray[10], (char*)&testArray[11]), 'b'); //differs only at the terminator
+	TestCaseInt(strncmp((char*)&testArray[10], (char*)&testArray[11], 100), 0);
+	TestCaseInt(strncmp((char*)&testArray[11], (char*)&testArray[10], 200), -'b');
 	
 	TestCaseInt(strlen((char*)&testArray[0]), 127);
+	TestCaseInt(strlen((char*)&testArray[3]), 124); //unaligned start
+	TestCaseInt(strlen((char*)&testArray[126]), 1);
+	TestCaseInt(strlen((char*)&testArray[127]), 0);
+	TestCaseInt((int)((char*)memchr(&testArray[1], 'b', 126) - (char*)&testArray[0]), 2);
+	TestCaseInt((int)((char*)memchr(&testArray[5], 'A', 100) - (char*)&testArray[0]), 5);
+	TestCaseInt((memchr(&testArray[11], 'A', 100) == nullptr), true);
+	TestCaseInt((memchr(&testArray[11], 'b', 0) == nullptr), true);
+	TestCaseInt((int)(strchr((char*)&testArray[7], 'b') - (char*)&testArray[0]), 10);
+	TestCaseInt((int)(strchr((char*)&testArray[1], '\0') - (char*)&testArray[0]), 127);
+	TestCaseInt((strchr((char*)&testArray[11], 'A') == nullptr), true);
+	TestCaseInt((int)(strrchr((char*)&testArray[0], 'A') - (char*)&testArray[0]), 9);
+	TestCaseInt((int)(strrchr((char*)&testArray[0], 'b') - (char*)&testArray[0]), 126);
+	TestCaseInt((strrchr((char*)&testArray[10], 'A') == nullptr), true);
+	
+	TestCaseInt(strspn((char*)&testArray[0], "A"), 2);
+	TestCaseInt(strspn((char*)&testArray[0], "bA"), 127);
+	TestCaseInt(strspn((char*)&testArray[3], "xyz"), 0);
+	TestCaseInt(strcspn((char*)&testArray[0], "b\xC0"), 2);
+	TestCaseInt(strcspn((char*)&testArray[4], "xyzb"), 6);
+	TestCaseInt(strcspn((char*)&testArray[10], "A"), 117);
+	TestCaseInt((int)(strpbrk((char*)&testArray[4], "?b") - (char*)&testArray[0]), 10);
+	TestCaseInt((strpbrk((char*)&testArray[10], "A\xC0") == nullptr), true);
+	
+	char tokenStr[] = "  width = 1280;;height=720 ";
+	char* tokenSavePntr = nullptr;
+	const char* expectedTokens[] = { "width", "1280", "height", "720" };
+	bool tokensCorrect = true;
+	int numTokens = 0;
+	for (char* token = strtok_r(tokenStr, " =;", &tokenSavePntr); token != nullptr; token = strtok_r(nullptr, " =;", &tokenSavePntr))
+	{
+		if (numTokens >= 4 || strcmp(token, expectedTokens[numTokens]) != 0) { tokensCorrect = false; }
+		numTokens++;
+	}
+	TestCaseInt(numTokens, 4);
+	TestCaseInt(tokensCorrect, true);
 	
 	TestCaseInt(wcslen((wchar_t*)&testArray[0]), 32);
+	char caseStr[] = "Textures/Player_IDLE.png and SOME MORE text to go past 16 bytes";
+	TestCaseInt(strcasecmp("textures/player_idle.PNG", "Textures/Player_IDLE.png"), 0);
+	TestCaseInt(strcasecmp("Textures/Player_IDLE.png and some more text to go past 16 bytes", caseStr), 0);
+	TestCaseInt(strcasecmp("abc", "ABD"), -1);
+	TestCaseInt(strcasecmp("[", "a"), '[' - 'a'); //'[' comes after 'A' but before 'a'
+	TestCaseInt(strncasecmp("SHADERS/main.glsl", "shaders/MAIN.frag", 13), 0);
+	TestCaseInt((strncasecmp("SHADERS/main.glsl", "shaders/MAIN.frag", 14) != 0), true);
+	TestCaseInt((int)(strcasestr(caseStr, "player_idle") - caseStr), 9);
+	TestCaseInt((strcasestr(caseStr, "player_walk") == nullptr), true);
+	static char caseRepeatStr[2001];
+	memset(caseRepeatStr, 'a', 2000);
+	caseRepeatStr[1999] = 'B';
+	TestCaseInt((int)(strcasestr(caseRepeatStr, "AAAAAAAAb") - caseRepeatStr), 1991); //every position is a candidate, this goes through the two-way fallback
+	TestCaseInt((strcasestr(caseRepeatStr, "AAAAAAAAc") == nullptr), true);
+	StdStrToLowerInPlace(caseStr, 30);
+	TestCaseInt(strncmp(caseStr, "textures/player_idle.png and sOME MORE", 38), 0);
+	StdStrToUpperInPlace(caseStr, 8);
+	TestCaseInt(strncmp(caseStr, "TEXTURES/player", 15), 0);
+	TestCaseInt(tolower('Q'), 'q');
+	TestCaseInt(toupper('['), '[');
+	TestCaseInt((isspace('\n') && isdigit('7') && isxdigit('f') && !isalpha('@')), true);
+	
+	const wchar_t* wideStr = L"Hello, \u4E16\u754C!";
+	wchar_t wideBuffer[20];
+	TestCaseInt(wcslen(wideStr), 10);
+	TestCaseInt((int)(wcschr(wideStr, L'\u754C') - wideStr), 8);
+	TestCaseInt((wcschr(wideStr, L'z') == nullptr), true);
+	TestCaseInt(wcscmp(wideStr, L"Hello, \u4E16\u754C!"), 0);
+	TestCaseInt(wcscmp(wideStr, L"Hello"), 1);
+	TestCaseInt(wcscmp(L"Hello, \u4E16", wideStr), -1);
+	wmemset(&wideBuffer[0], L'x', 19);
+	wideBuffer[19] = L'\0';
+	TestCaseInt(wcslen(&wideBuffer[0]), 19);
+	wmemcpy(&wideBuffer[0], wideStr, 11);
+	TestCaseInt(wcscmp(&wideBuffer[0], wideStr), 0);
+	TestCaseInt(wideBuffer[11], L'x');
 	
 	if (numCasesSucceeded == numCases)
 	{
@@ -642,6 +746,15 @@ int CompareU32(const void* left, const void* right)
 	return ((*leftU32 > *rightU32) ? 1 : -1);
 }
 
+bool IsSortedU32(const uint32_t* elements, int numElements)
+{
+	for (int eIndex = 1; eIndex < numElements; eIndex++)
+	{
+		if (elements[eIndex - 1] > elements[eIndex]) { return false; }
+	}
+	return true;
+}
+
 void RunStdLibTestCases()
 {
 	int numCases = 0;
@@ -699,11 +812,38 @@ void RunStdLibTestCases()
 	uint32_t elements[] = { 1, 5, 7, 2, 6, 4, 3, 8 };
 	const int numElements = (sizeof(elements) / sizeof(uint32_t));
 	qsort(elements, numElements, sizeof(uint32_t), CompareU32);
-	for (int eIndex = 0; eIndex < numElements; eIndex++)
+	TestCaseInt(IsSortedU32(elements, numElements), true);
+	TestCaseInt(elements[0], 1);
+	TestCaseInt(elements[7], 8);
+	
+	// Big enough to go through the ninther pivot and block partitioning rather than just insertion sort
+	static uint32_t bigElements[1000];
+	const int numBigElements = (sizeof(bigElements) / sizeof(uint32_t));
+	uint32_t randomState = 12345;
+	for (int eIndex = 0; eIndex < numBigElements; eIndex++) { randomState = (randomState * 1103515245) + 12345; bigElements[eIndex] = (randomState >> 16); }
+	qsort(bigElements, numBigElements, sizeof(uint32_t), CompareU32);
+	TestCaseInt(IsSortedU32(bigElements, numBigElements), true);
+	for (int eIndex = 0; eIndex < numBigElements; eIndex++) { bigElements[eIndex] = (uint32_t)(numBigElements - eIndex); } //reversed
+	qsort(bigElements, numBigElements, sizeof(uint32_t), CompareU32);
+	TestCaseInt(IsSortedU32(bigElements, numBigElements), true);
+	TestCaseInt(bigElements[0], 1);
+	for (int eIndex = 0; eIndex < numBigElements; eIndex++) { bigElements[eIndex] = (uint32_t)(eIndex % 3); } //lots of duplicates
+	qsort(bigElements, numBigElements, sizeof(uint32_t), CompareU32);
+	TestCaseInt(IsSortedU32(bigElements, numBigElements), true);
+	TestCaseInt(bigElements[333], 0);
+	TestCaseInt(bigElements[334], 1);
+	
+	// Items bigger than the key, the rest of each item has to move along with it
+	uint32_t wideElements[200][3];
+	const int numWideElements = (sizeof(wideElements) / sizeof(wideElements[0]));
+	for (int eIndex = 0; eIndex < numWideElements; eIndex++) { wideElements[eIndex][0] = (uint32_t)((eIndex * 7919) % numWideElements); wideElements[eIndex][1] = wideElements[eIndex][0] * 2; wideElements[eIndex][2] = wideElements[eIndex][0] * 3; }
+	qsort(wideElements, numWideElements, sizeof(wideElements[0]), CompareU32);
+	bool wideElementsCorrect = true;
+	for (int eIndex = 0; eIndex < numWideElements; eIndex++)
 	{
-		jsPrintInteger("", elements[eIndex]);
+		if (wideElements[eIndex][0] != (uint32_t)eIndex || wideElements[eIndex][1] != (uint32_t)eIndex * 2 || wideElements[eIndex][2] != (uint32_t)eIndex * 3) { wideElementsCorrect = false; }
 	}
-	//TODO: Add tests for qsort
+	TestCaseInt(wideElementsCorrect, true);
 	
 	if (numCasesSucceeded == numCases)
 	{
@@ -717,6 +857,255 @@ void RunStdLibTestCases()
 	}
 }
 
+void RunHeapTestCases()
+{
+	int numCases = 0;
+	int numCasesSucceeded = 0;
+	
+	uint8_t* alloc1 = (uint8_t*)malloc(100);
+	TestCaseInt(alloc1 != nullptr, true);
+	TestCaseInt(((uintptr_t)alloc1 % 8), 0);
+	memset(alloc1, 0xAA, 100);
+	free(alloc1);
+	uint8_t* alloc2 = (uint8_t*)malloc(100);
+	TestCaseInt((alloc2 == alloc1), true); //freed memory should get reused
+	
+	uint8_t* alloc3 = (uint8_t*)calloc(25, 4);
+	bool allZero = true;
+	for (int bIndex = 0; bIndex < 100; bIndex++) { if (alloc3[bIndex] != 0) { allZero = false; } }
+	TestCaseInt(allZero, true);
+	
+	for (int bIndex = 0; bIndex < 100; bIndex++) { alloc2[bIndex] = (uint8_t)bIndex; }
+	alloc2 = (uint8_t*)realloc(alloc2, 5000);
+	bool contentsKept = true;
+	for (int bIndex = 0; bIndex < 100; bIndex++) { if (alloc2[bIndex] != (uint8_t)bIndex) { contentsKept = false; } }
+	TestCaseInt(contentsKept, true);
+	alloc2 = (uint8_t*)realloc(alloc2, 50);
+	contentsKept = true;
+	for (int bIndex = 0; bIndex < 50; bIndex++) { if (alloc2[bIndex] != (uint8_t)bIndex) { contentsKept = false; } }
+	TestCaseInt(contentsKept, true);
+	
+	free(alloc2);
+	free(alloc3);
+	free(nullptr);
+	
+	// Small allocations in the same size class should reuse the slot that was just freed
+	void* smallAlloc1 = malloc(24);
+	free(smallAlloc1);
+	void* smallAlloc2 = malloc(20);
+	TestCaseInt((smallAlloc2 == smallAlloc1), true);
+	void* smallAlloc3 = malloc(24);
+	TestCaseInt(((uint8_t*)smallAlloc3 - (uint8_t*)smallAlloc2), 32); //no header between small blocks
+	free(smallAlloc2);
+	free(smallAlloc3);
+	bool smallAllocsAligned = true;
+	for (size_t allocSize = 16; allocSize <= 256; allocSize++)
+	{
+		void* smallAlloc = malloc(allocSize);
+		if (((uintptr_t)smallAlloc % 16) != 0) { smallAllocsAligned = false; }
+		free(smallAlloc);
+	}
+	TestCaseInt(smallAllocsAligned, true); //anything that could hold a long double needs 16-byte alignment
+	
+	// Repeatedly allocating and freeing should keep reusing the same memory rather than growing the heap
+	void* firstLargeAlloc = malloc(256*1024);
+	free(firstLargeAlloc);
+	bool largeAllocsReused = true;
+	for (int aIndex = 0; aIndex < 100; aIndex++)
+	{
+		void* largeAlloc = malloc(256*1024);
+		if (largeAlloc != firstLargeAlloc) { largeAllocsReused = false; }
+		free(largeAlloc);
+	}
+	TestCaseInt(largeAllocsReused, true);
+	
+	void* oddAlloc = malloc(301); //odd sizes shouldn't throw off the alignment of the next allocation
+	void* largeAlloc = malloc(1000);
+	TestCaseInt(((uintptr_t)largeAlloc % 16), 0);
+	bool alignmentsRespected = true;
+	void* alignedAllocs[17];
+	for (int aIndex = 0; aIndex <= 16; aIndex++)
+	{
+		size_t alignment = ((size_t)1 << aIndex);
+		alignedAllocs[aIndex] = aligned_alloc(alignment, 40 + aIndex);
+		if (alignedAllocs[aIndex] == nullptr || ((uintptr_t)alignedAllocs[aIndex] % alignment) != 0) { alignmentsRespected = false; }
+	}
+	TestCaseInt(alignmentsRespected, true);
+	for (int aIndex = 0; aIndex <= 16; aIndex++) { free(alignedAllocs[aIndex]); }
+	TestCaseInt((aligned_alloc(24, 100) == nullptr), true); //not a power of two
+	free(oddAlloc);
+	free(largeAlloc);
+	
+	// operator new/delete go to the same heap as malloc/free
+	struct alignas(64) OverAlignedStruct_t { uint8_t bytes[100]; };
+	uint32_t* newInt = new uint32_t(1234);
+	TestCaseInt((int)*newInt, 1234);
+	delete newInt;
+	void* reusedAlloc = malloc(sizeof(uint32_t));
+	TestCaseInt((reusedAlloc == (void*)newInt), true);
+	free(reusedAlloc);
+	uint8_t* newArray = new uint8_t[1000];
+	TestCaseInt(((uintptr_t)newArray % 16), 0);
+	delete[] newArray;
+	OverAlignedStruct_t* overAligned = new OverAlignedStruct_t;
+	TestCaseInt(((uintptr_t)overAligned % 64), 0);
+	delete overAligned;
+	uint32_t placementStorage = 0;
+	uint32_t* placementInt = new (&placementStorage) uint32_t(5678);
+	TestCaseInt((placementInt == &placementStorage && placementStorage == 5678), true);
+	
+	if (numCasesSucceeded == numCases)
+	{
+		jsPrintInteger("All Heap Tests Succeeded", numCases);
+	}
+	else
+	{
+		jsPrintInteger("Some Heap Tests Failed", numCases);
+		jsPrintInteger("Successes", numCasesSucceeded);
+		jsPrintInteger("Failures", numCases - numCasesSucceeded);
+	}
+}
+
+void RunArenaTestCases()
+{
+	int numCases = 0;
+	int numCasesSucceeded = 0;
+	
+	StdArena_t arena;
+	InitStdArenaPages(&arena, 1);
+	TestCaseInt(((uintptr_t)arena.basePntr % WASM_MEMORY_PAGE_SIZE), 0);
+	TestCaseInt(arena.size, WASM_MEMORY_PAGE_SIZE);
+	
+	uint8_t* push1 = (uint8_t*)StdArenaPush(&arena, 3, 1);
+	TestCaseInt((push1 == arena.basePntr), true);
+	uint8_t* push2 = (uint8_t*)StdArenaPush(&arena, 16, 16);
+	TestCaseInt((push2 - arena.basePntr), 16);
+	TestCaseInt(arena.used, 32);
+	
+	StdArenaMark_t mark = StdArenaPushMark(&arena);
+	StdArenaPush(&arena, 1000, 8);
+	TestCaseInt(arena.used, 1032);
+	StdArenaPopMark(&arena, mark);
+	TestCaseInt(arena.used, 32);
+	TestCaseInt(arena.highUsedMark, 1032);
+	
+	TestCaseInt((StdArenaPush(&arena, WASM_MEMORY_PAGE_SIZE, 1) == nullptr), true);
+	StdArenaReset(&arena);
+	TestCaseInt(arena.used, 0);
+	TestCaseInt((StdArenaPush(&arena, WASM_MEMORY_PAGE_SIZE, 1) == arena.basePntr), true);
+	StdArenaReset(&arena);
+	StdArenaPush(&arena, 1, 1);
+	TestCaseInt((StdArenaPush(&arena, 0xFFFFFFF9, 8) == nullptr), true); //numBytes + alignPadding wraps to 0
+	TestCaseInt(arena.used, 1);
+	
+	InitStdFrameArenas(1);
+	uint8_t* framePush1 = (uint8_t*)StdFramePush(64, 8);
+	framePush1[0] = 0x42;
+	StdBeginFrame();
+	TestCaseInt((GetStdPrevFrameArena()->basePntr == framePush1), true);
+	TestCaseInt(framePush1[0], 0x42); //last frame's data is still valid
+	uint8_t* framePush2 = (uint8_t*)StdFramePush(64, 8);
+	TestCaseInt((framePush2 != framePush1), true);
+	StdBeginFrame();
+	TestCaseInt(GetStdFrameArena()->used, 0);
+	TestCaseInt((StdFramePush(64, 8) == framePush1), true);
+	
+	if (numCasesSucceeded == numCases)
+	{
+		jsPrintInteger("All Arena Tests Succeeded", numCases);
+	}
+	else
+	{
+		jsPrintInteger("Some Arena Tests Failed", numCases);
+		jsPrintInteger("Successes", numCasesSucceeded);
+		jsPrintInteger("Failures", numCases - numCasesSucceeded);
+	}
+}
+
+void RunHashTestCases()
+{
+	int numCases = 0;
+	int numCasesSucceeded = 0;
+	
+	// Known XXH64 values
+	TestCaseInt((StdHash64("", 0, 0) == 0xEF46DB3751D8E999ULL), true);
+	TestCaseInt((StdHashStr64("abc", 0) == 0x44BC2CF5AD770999ULL), true);
+	TestCaseInt((StdHashStr64("abc", 1) != StdHashStr64("abc", 0)), true);
+	
+	uint8_t hashData[200];
+	for (uint32_t bIndex = 0; bIndex < sizeof(hashData); bIndex++) { hashData[bIndex] = (uint8_t)(bIndex * 7); }
+	uint64_t wholeHash = StdHash64(&hashData[0], sizeof(hashData), 1234);
+	StdHashState_t hashState;
+	StdHashStart(&hashState, 1234);
+	StdHashUpdate(&hashState, &hashData[0], 5);
+	StdHashUpdate(&hashState, &hashData[5], 40);
+	StdHashUpdate(&hashState, &hashData[45], 155);
+	TestCaseInt((StdHashFinish(&hashState) == wholeHash), true);
+	
+	constexpr uint64_t compileTimeHash = StdHashLiteral("Textures/player_idle.png");
+	TestCaseInt((compileTimeHash == StdHashStr64("Textures/player_idle.png", 0)), true);
+	
+	if (numCasesSucceeded == numCases)
+	{
+		jsPrintInteger("All Hash Tests Succeeded", numCases);
+	}
+	else
+	{
+		jsPrintInteger("Some Hash Tests Failed", numCases);
+		jsPrintInteger("Successes", numCasesSucceeded);
+		jsPrintInteger("Failures", numCases - numCasesSucceeded);
+	}
+}
+
+void RunUtfTestCases()
+{
+	int numCases = 0;
+	int numCasesSucceeded = 0;
+	
+	// "Price: 5€ 😀" followed by enough ASCII to go through the 16 byte fast path
+	const char* utf8Str = "Price: 5\xE2\x82\xAC \xF0\x9F\x98\x80 and then some more plain ASCII text";
+	size_t utf8Length = strlen(utf8Str);
+	uint16_t utf16Buffer[64];
+	uint32_t utf32Buffer[64];
+	char utf8Buffer[64*3];
+	
+	TestCaseInt(StdUtf8Validate(utf8Str, utf8Length), true);
+	TestCaseInt(StdUtf8Validate("\xC0\xAF", 2), false); //overlong '/'
+	TestCaseInt(StdUtf8Validate("\xED\xA0\x80", 3), false); //surrogate
+	TestCaseInt(StdUtf8Validate("\xF4\x90\x80\x80", 4), false); //above U+10FFFF
+	TestCaseInt(StdUtf8Validate(utf8Str, 10), false); //cut off in the middle of the euro sign
+	
+	size_t utf16Length = StdUtf8ToUtf16(utf8Str, utf8Length, &utf16Buffer[0]);
+	TestCaseInt((int)utf16Length, (int)StdUtf16LengthFromUtf8(utf8Str, utf8Length));
+	TestCaseInt((int)utf16Length, (int)utf8Length - 4);
+	TestCaseInt(utf16Buffer[8], 0x20AC);
+	TestCaseInt(utf16Buffer[10], 0xD83D);
+	TestCaseInt(utf16Buffer[11], 0xDE00);
+	TestCaseInt((int)StdUtf16ToUtf8(&utf16Buffer[0], utf16Length, &utf8Buffer[0]), (int)utf8Length);
+	TestCaseInt(memcmp(&utf8Buffer[0], utf8Str, utf8Length), 0);
+	
+	size_t utf32Length = StdUtf8ToUtf32(utf8Str, utf8Length, &utf32Buffer[0]);
+	TestCaseInt((int)utf32Length, (int)StdUtf32LengthFromUtf8(utf8Str, utf8Length));
+	TestCaseInt(utf32Buffer[10], 0x1F600);
+	TestCaseInt((int)StdUtf32ToUtf8(&utf32Buffer[0], utf32Length, &utf8Buffer[0]), (int)utf8Length);
+	TestCaseInt(memcmp(&utf8Buffer[0], utf8Str, utf8Length), 0);
+	
+	TestCaseInt((StdUtf8ToUtf16("ab\xFF", 3, &utf16Buffer[0]) == STD_UTF_INVALID), true);
+	utf16Buffer[0] = 0xDC00; //unpaired low surrogate
+	TestCaseInt((StdUtf16ToUtf8(&utf16Buffer[0], 1, &utf8Buffer[0]) == STD_UTF_INVALID), true);
+	
+	if (numCasesSucceeded == numCases)
+	{
+		jsPrintInteger("All UTF Tests Succeeded", numCases);
+	}
+	else
+	{
+		jsPrintInteger("Some UTF Tests Failed", numCases);
+		jsPrintInteger("Successes", numCasesSucceeded);
+		jsPrintInteger("Failures", numCases - numCasesSucceeded);
+	}
+}
+
 void RunStdioTestCases()
 {
 	int numCases = 0;
@@ -25,6 +25,7 @@ var stdGlobals =
 	glContext: null,
 	wasmMemory: null,
 	wasmModule: null,
+	memoryGrownCallbacks: [],
 };
 
 // +--------------------------------------------------------------+
@@ -110,15 +111,16 @@ function jsStdGetHeapSize()
 	return stdGlobals.wasmMemory.buffer.byteLength - stdGlobals.heapBase;
 }
 
-//TODO:
-// __builtin_wasm_memory_size(0); // the number of 64Kb pages we have
-// __builtin_wasm_memory_grow(0, blocks); // increases amount of pages
-// __builtin_huge_valf(); // similar to Infinity in JS
-function jsStdGrowMemory(numPages)
+// The module grows it's own memory with memory.grow (see WasmMemoryGrow in std_wasm_memory.c) and calls
+// this afterwards. Growing detaches the old ArrayBuffer, so any typed array views that were created on
+// wasmMemory.buffer need to be recreated. Register for this with PigWasm_AddMemoryGrownCallback
+function jsStdMemoryGrown(prevNumPages, newNumPages)
 {
-	let currentPageCount = stdGlobals.wasmMemory.buffer.byteLength / WASM_MEMORY_PAGE_SIZE;
-	// console.log("Memory growing by " + numPages + " pages (" + currentPageCount + " -> " + (currentPageCount + numPages) + ")");
-	stdGlobals.wasmMemory.grow(numPages);
+	// console.log("Memory grew by " + (newNumPages - prevNumPages) + " pages (" + prevNumPages + " -> " + newNumPages + ")");
+	for (let callback of stdGlobals.memoryGrownCallbacks)
+	{
+		callback(stdGlobals.wasmMemory, prevNumPages, newNumPages);
+	}
 }
 
 jsStdApiFuncs =
@@ -126,7 +128,7 @@ jsStdApiFuncs =
 	jsStdAbort: jsStdAbort,
 	jsStdAssertFailure: jsStdAssertFailure,
 	jsStdDebugBreak: jsStdDebugBreak,
-	jsStdGrowMemory: jsStdGrowMemory,
+	jsStdMemoryGrown: jsStdMemoryGrown,
 	jsStdGetHeapSize: jsStdGetHeapSize,
 };
 
@@ -162,9 +164,84 @@ function PigWasm_CreateGlContext(canvas)
 	return canvasContextGl;
 }
 
+// callback(wasmMemory, prevNumPages, newNumPages) is called whenever the wasm module grows it's memory
+function PigWasm_AddMemoryGrownCallback(callback)
+{
+	stdGlobals.memoryGrownCallbacks.push(callback);
+}
+
+// Returns an object with the fields of WasmMemoryStats_t (see std_wasm_memory.c), allocCounts and freeCounts
+// are arrays with one entry per slab size class and a last entry for allocations that went to the TLSF heap
+function PigWasm_GetMemoryStats()
+{
+	let statsPntr = stdGlobals.wasmModule.exports.GetWasmMemoryStats();
+	let statsView = new Uint32Array(stdGlobals.wasmMemory.buffer, statsPntr);
+	let numSizeClasses = statsView[9];
+	return {
+		numPagesAllocated:   statsView[0],
+		numGrows:            statsView[1],
+		liveBytes:           statsView[2],
+		peakLiveBytes:       statsView[3],
+		freeBytes:           statsView[4],
+		largestFreeBlock:    statsView[5],
+		fragmentedBytes:     statsView[6],
+		overheadBytes:       statsView[7],
+		alignmentWasteBytes: statsView[8],
+		allocCounts: Array.from(statsView.subarray(10, 10 + numSizeClasses)),
+		freeCounts:  Array.from(statsView.subarray(10 + numSizeClasses, 10 + numSizeClasses*2)),
+	};
+}
+
+// Groups the samples in the heap profiler's ring buffer by tag. Returns an array of
+// { tag, numSamples, estimatedBytes, largestAlloc } sorted so the tags that allocated the most come first.
+// The wasm module must be compiled with WASM_HEAP_PROFILER_ENABLED=1 for this to return anything
+function PigWasm_GetHeapProfile()
+{
+	let exports = stdGlobals.wasmModule.exports;
+	if (exports.GetStdHeapProfilerInfo === undefined) { console.warn("The heap profiler was not compiled in! Define WASM_HEAP_PROFILER_ENABLED=1"); return []; }
+	let infoView = new Uint32Array(stdGlobals.wasmMemory.buffer, exports.GetStdHeapProfilerInfo(), 4);
+	let samplesPntr = infoView[0];
+	let maxNumSamples = infoView[1];
+	let numSamplesRecorded = infoView[2];
+	let sampleInterval = infoView[3];
+	
+	let samplesView = new Uint32Array(stdGlobals.wasmMemory.buffer, samplesPntr, maxNumSamples * 3);
+	let numSamples = Math.min(numSamplesRecorded, maxNumSamples);
+	let entriesByTag = new Map();
+	for (let sIndex = 0; sIndex < numSamples; sIndex++)
+	{
+		let tagPntr = samplesView[sIndex*3 + 0];
+		let allocSize = samplesView[sIndex*3 + 1];
+		let weight = samplesView[sIndex*3 + 2];
+		let entry = entriesByTag.get(tagPntr);
+		if (entry === undefined)
+		{
+			let tag = ((tagPntr != 0) ? wasmPntrToJsString(stdGlobals.wasmMemory, tagPntr) : "(untagged)");
+			entry = { tag: tag, numSamples: 0, estimatedBytes: 0, largestAlloc: 0 };
+			entriesByTag.set(tagPntr, entry);
+		}
+		entry.numSamples += weight;
+		entry.estimatedBytes += weight * sampleInterval;
+		entry.largestAlloc = Math.max(entry.largestAlloc, allocSize);
+	}
+	
+	let result = Array.from(entriesByTag.values());
+	result.sort((left, right) => (right.estimatedBytes - left.estimatedBytes));
+	return result;
+}
+
+// Pass shared=true when the module was compiled with -matomics (and linked with --shared-memory) so the memory can be
+// handed to workers. Shared memory is required to have a maximum so we default to the most the allocator will use (2GB)
 function PigWasm_InitMemory(initialMemPageCount, shared, maximumNumPages)
 {
-	wasmMemory = new WebAssembly.Memory({ initial: initialMemPageCount });
+	let memoryDescriptor = { initial: initialMemPageCount };
+	if (maximumNumPages !== undefined && maximumNumPages > 0) { memoryDescriptor.maximum = maximumNumPages; }
+	if (shared === true)
+	{
+		memoryDescriptor.shared = true;
+		if (memoryDescriptor.maximum === undefined) { memoryDescriptor.maximum = (2 * 1024 * 1024 * 1024) / WASM_MEMORY_PAGE_SIZE; }
+	}
+	wasmMemory = new WebAssembly.Memory(memoryDescriptor);
 	stdGlobals.wasmMemory = wasmMemory;
 	return wasmMemory
 }